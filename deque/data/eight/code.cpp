@@ -0,0 +1,20 @@
+#define SJTU_STATS
+#include "deque.hpp"
+
+#include <iostream>
+
+int main()
+{
+	std::cout << "Testing stats..." << std::endl;
+	sjtu::deque<int> a;
+	for (int i = 0; i < 3000; ++i) {
+		a.push_front(i);
+	}
+	std::cout << a.stats().splits << " " << a.stats().merges << std::endl;
+	a.reset_stats();
+	for (int i = 0; i < 2000; ++i) {
+		a.pop_front();
+	}
+	std::cout << a.stats().splits << " " << a.stats().merges << std::endl;
+	return 0;
+}
@@ -0,0 +1,29 @@
+#define SJTU_UNCHECKED
+#include "deque.hpp"
+
+#include <iostream>
+
+static_assert(!sjtu::checked_access, "unchecked");
+
+int main()
+{
+	std::cout << "Testing unchecked..." << std::endl;
+	sjtu::deque<int> a;
+	for (int i = 0; i < 3000; ++i) {
+		a.push_back(i);
+		a.push_front(-i);
+	}
+	a.insert(a.begin() + 100, 7);
+	a.erase(a.begin() + 200);
+	long long sum = 0;
+	for (sjtu::deque<int>::const_iterator it = a.cbegin(); it != a.cend(); ++it) {
+		sum += *it;
+	}
+	std::cout << a.size() << " " << a[0] << " " << a[100] << " " << a[5999] << " " << (a.end() - a.begin()) << " " << sum << std::endl;
+	try {
+		a.at(6000);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at is checked" << std::endl;
+	}
+	return 0;
+}
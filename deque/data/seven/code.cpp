@@ -0,0 +1,62 @@
+#include "deque.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+void TestSaveLoad()
+{
+	std::cout << "Testing save and load..." << std::endl;
+	sjtu::deque<int> a;
+	for (int i = 0; i < 5000; ++i) {
+		a.push_back(i);
+		a.push_front(-i);
+	}
+	sjtu::deque<std::string> b;
+	for (int i = 0; i < 1000; ++i) {
+		b.push_front(std::to_string(i));
+	}
+	std::stringstream ss;
+	a.save(ss);
+	b.save(ss);
+	sjtu::deque<int> a2;
+	a2.push_back(42);
+	sjtu::deque<std::string> b2;
+	a2.load(ss);
+	b2.load(ss);
+	bool ok = a2.size() == a.size() && b2.size() == b.size();
+	for (size_t i = 0; i < a.size(); ++i) {
+		ok = ok && a2[i] == a[i];
+	}
+	for (size_t i = 0; i < b.size(); ++i) {
+		ok = ok && b2[i] == b[i];
+	}
+	std::cout << ok << " " << a2.front() << " " << a2.back() << " " << b2.front() << " " << b2.back() << std::endl;
+	//the loaded deque works as any other
+	a2.push_front(100000);
+	a2.insert(a2.begin() + 1, 100001);
+	a2.erase(a2.begin() + 500);
+	for (int i = 0; i < 3000; ++i) {
+		a2.pop_front();
+	}
+	a2.push_back(-100000);
+	int sum = 0;
+	for (sjtu::deque<int>::iterator it = a2.begin(); it != a2.end(); ++it) {
+		sum += *it;
+	}
+	std::cout << a2.size() << " " << a2.front() << " " << a2.back() << " " << sum << std::endl;
+	sjtu::deque<short> c;
+	std::stringstream tt;
+	a.save(tt);
+	try {
+		c.load(tt);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "wrong type " << c.size() << std::endl;
+	}
+}
+
+int main()
+{
+	TestSaveLoad();
+	return 0;
+}
@@ -5,6 +5,9 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <memory>
+#include "allocator.hpp"
+#include "serialize.hpp"
 
 /*
  * This is a pile of very ugly code.
@@ -16,7 +19,11 @@ namespace sjtu {
 
 const int MAXS = 300;
 
-template<class T>
+/**
+ * the arrays of elements are allocated by Alloc,
+ * and the blocks by Alloc rebound to the block type, see allocator.hpp.
+ */
+template<class T, class Alloc = allocator<T>>
 class deque {
 
     //friends and types declaration
@@ -32,12 +39,41 @@ public:
     using size_type         = size_t;
     using difference_type   = ptrdiff_t;
 
+    //what the deque has done to its blocks, counted only if SJTU_STATS is defined
+    //each split or merge copies the elements of a block one by one
+    struct stats_type{
+        size_t splits = 0;
+        size_t merges = 0;
+    };
+
     //private members, including the definition of block
 private:
     size_type _size = 0;
+#ifdef SJTU_STATS
+    stats_type _stats;
+#endif
     class _Block;
 
-    _Block *head = new _Block(), *tail = new _Block();
+    using _BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_Block>;
+    Alloc _alloc;
+    _BlockAlloc _block_alloc;
+
+    _Block *_newBlock(_Block *p = nullptr, _Block *n = nullptr) {
+        _Block *b = _block_alloc.allocate(1);
+        new (b) _Block(p, n);
+        return b;
+    }
+    //dispose the elements and the block
+    void _deleteBlock(_Block *b) {
+        b->_clear(_alloc);
+        b->~_Block();
+        _block_alloc.deallocate(b, 1);
+    }
+    T *_newData() {
+        return _alloc.allocate(MAXS + 1);
+    }
+
+    _Block *head = _newBlock(), *tail = _newBlock();
 
     //----------class _Block----------
     class _Block{
@@ -55,26 +91,27 @@ private:
         ~_Block() {}
 
         //dispose T and free memory
-        void _clear() {
+        void _clear(Alloc &a) {
             if (data == nullptr)
                 return;
             for (size_type i = 0; i < len; ++i)
                 (data + i)->~T();
-            free(data);
+            a.deallocate(data, MAXS + 1);
         }
 
         //split this block from pos(0-base)
         //elements including the one at pos will be transferred to a new block
-        void _split(size_type pos) {
+        void _split(size_type pos, deque &d) {
             if (pos >= len || pos < 0)
                 return;
-            _Block *b = new _Block(this, next);
+            SJTU_STAT(++d._stats.splits);
+            _Block *b = d._newBlock(this, next);
             if (next != nullptr)
                 next->prev = b;
             next = b;
             if (prev->prev != nullptr) {
                 b->len = len - pos;
-                b->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+                b->data = d._newData();
                 for (size_type i = 0; i < len - pos; ++i) {
                     new (b->data + i) T(*(data + i + pos));
                     (data + i + pos)->~T();
@@ -83,7 +120,7 @@ private:
             }
             else { //specially dealing with the first block
                 b->len = pos + 1;
-                b->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+                b->data = d._newData();
                 for (size_type i = 0; i < pos + 1; ++i) {
                     new (b->data + i) T(*(data + pos - i));
                     (data + pos - i)->~T();
@@ -97,12 +134,13 @@ private:
         }
 
         //merge the next block into this block
-        bool _merge() {
+        bool _merge(deque &d) {
             _Block *b = next;
             if (b == nullptr || b->next == nullptr)
                 return false;
             if (len + b->len > MAXS)
                 return false;
+            SJTU_STAT(++d._stats.merges);
             next = b->next;
             if (next != nullptr)
                 next->prev = this;
@@ -120,8 +158,7 @@ private:
                 }
                 len += b->len;
             }
-            b->_clear();
-            delete b;
+            d._deleteBlock(b);
             return true;
         }
     };
@@ -134,8 +171,7 @@ private:
         while (p != nullptr) {
             q = p;
             p = p->next;
-            q->_clear();
-            delete q;
+            _deleteBlock(q);
         }
         _size = 0;
     }
@@ -256,7 +292,7 @@ public:
         }
 
         difference_type operator -(const iterator &rhs) const {
-            if (_container != rhs._container)
+            if (checked_access && _container != rhs._container)
                 throw invalid_iterator();
 
             _Block *b = rhs._ptr;
@@ -311,7 +347,7 @@ public:
         }
 
         iterator operator ++(int) {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _container->tail)
                 throw invalid_iterator();
             iterator t = *this;
             if (_ptr != _container->head->next) {
@@ -331,7 +367,7 @@ public:
             return t;
         }
         iterator &operator ++() {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _container->tail)
                 throw invalid_iterator();
             if (_ptr != _container->head->next) {
                 ++_pos;
@@ -395,12 +431,12 @@ public:
         }
 		
 		T &operator *() const {
-            if (_ptr == nullptr || _ptr->data == nullptr)
+            if (checked_access && (_ptr == nullptr || _ptr->data == nullptr))
                 throw invalid_iterator();
             return *(_ptr->data + _pos);
         }
 		T *operator ->() const noexcept {
-            if (_ptr == nullptr || _ptr->data == nullptr)
+            if (checked_access && (_ptr == nullptr || _ptr->data == nullptr))
                 throw invalid_iterator();
             return _ptr->data + _pos;
         }
@@ -532,7 +568,7 @@ public:
         }
 
         difference_type operator -(const const_iterator &rhs) const {
-            if (_container != rhs._container)
+            if (checked_access && _container != rhs._container)
                 throw invalid_iterator();
             _Block *b = rhs._ptr;
             if (b == _ptr) {
@@ -583,7 +619,7 @@ public:
         }
 
         const_iterator operator ++(int) {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _container->tail)
                 throw invalid_iterator();
             const_iterator t = *this;
             if (_ptr != _container->head->next) {
@@ -603,7 +639,7 @@ public:
             return t;
         }
         const_iterator &operator ++() {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _container->tail)
                 throw invalid_iterator();
             if (_ptr != _container->head->next) {
                 ++_pos;
@@ -667,12 +703,12 @@ public:
         }
 
         T &operator *() const {
-            if (_ptr == nullptr || _ptr->data == nullptr)
+            if (checked_access && (_ptr == nullptr || _ptr->data == nullptr))
                 throw invalid_iterator();
             return *(_ptr->data + _pos);
         }
         T *operator ->() const noexcept {
-            if (_ptr == nullptr || _ptr->data == nullptr)
+            if (checked_access && (_ptr == nullptr || _ptr->data == nullptr))
                 throw invalid_iterator();
             return _ptr->data + _pos;
         }
@@ -698,14 +734,18 @@ public:
         head->next = tail;
         tail->prev = head;
     }
-	deque(const deque &other) {
+	explicit deque(const Alloc &alloc) : _alloc(alloc), _block_alloc(alloc) {
+        head->next = tail;
+        tail->prev = head;
+    }
+	deque(const deque &other) : _alloc(other._alloc), _block_alloc(other._block_alloc) {
         _Block *p = head, *q = other.head;
         while (q->next != other.tail) {
             q = q->next;
-            p->next = new _Block(p);
+            p->next = _newBlock(p);
             p->next->prev = p;
             p = p->next;
-            p->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+            p->data = _newData();
             p->len = q->len;
             for (size_type i = 0; i < p->len; ++i)
                 new (p->data + i) T(*(q->data + i));
@@ -724,15 +764,15 @@ public:
             return *this;
         
         _clear();
-        head = new _Block();
-        tail = new _Block();
+        head = _newBlock();
+        tail = _newBlock();
         _Block *p = head, *q = other.head;
         while (q->next != other.tail) {
             q = q->next;
-            p->next = new _Block(p);
+            p->next = _newBlock(p);
             p->next->prev = p;
             p = p->next;
-            p->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+            p->data = _newData();
             p->len = q->len;
             for (size_type i = 0; i < p->len; ++i)
                 new (p->data + i) T(*(q->data + i));
@@ -796,7 +836,7 @@ public:
         }
     }
 	T &operator [](const size_type &pos) {
-        if (pos < 0 || pos >= _size)
+        if (checked_access && pos >= _size)
             throw index_out_of_bound();
         size_type d = pos;
         _Block *p = head->next;
@@ -821,7 +861,7 @@ public:
         }
     }
 	const T &operator [](const size_type &pos) const {
-        if (pos < 0 || pos >= _size)
+        if (checked_access && pos >= _size)
             throw index_out_of_bound();
         size_type d = pos;
         _Block *p = head->next;
@@ -889,13 +929,24 @@ public:
 	size_type size() const {
         return _size;
     }
+
+	stats_type stats() const {
+#ifdef SJTU_STATS
+        return _stats;
+#else
+        return stats_type();
+#endif
+    }
+	void reset_stats() {
+        SJTU_STAT(_stats = stats_type());
+    }
 	
     //outer version of clear()
     //must relink head and tail after using inner _clear()
 	void clear() {
         _clear();
-        head = new _Block();
-        tail = new _Block();
+        head = _newBlock();
+        tail = _newBlock();
         head->next = tail;
         tail->prev = head;
     }
@@ -903,19 +954,19 @@ public:
     //insert value in front of pos
     //return an iterator point at value
 	iterator insert(iterator pos, const T &value) {
-        if (pos._container != this || pos._ptr == nullptr)
+        if (checked_access && (pos._container != this || pos._ptr == nullptr))
             throw invalid_iterator();
 
         size_type d = pos - begin();
         ++_size;
         if (pos._ptr->len >= MAXS) {
             if (pos._ptr != head->next) {
-                pos._ptr->_split(pos._pos);
+                pos._ptr->_split(pos._pos, *this);
                 new (pos._ptr->data + pos._ptr->len) T(value);
                 ++pos._ptr->len;
             }
             else { //specially dealing with the first block
-                pos._ptr->_split(pos._pos);
+                pos._ptr->_split(pos._pos, *this);
                 for (size_type i = pos._ptr->len; i > 0; --i) {
                     new (pos._ptr->data + i) T(*(pos._ptr->data + i - 1));
                     (pos._ptr->data + i - 1)->~T();
@@ -928,11 +979,11 @@ public:
         }
         else if (pos._ptr == tail) {
             if (pos._ptr->prev == head) { //specially dealing with the first block
-                tail->prev->next = new _Block(tail->prev, tail);
+                tail->prev->next = _newBlock(tail->prev, tail);
                 _Block *b = tail->prev->next;
                 b->prev->next = b;
                 b->next->prev = b;
-                b->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+                b->data = _newData();
                 new (b->data) T(value);
                 b->len = 1;
                 return iterator(b, 0, this);
@@ -940,7 +991,7 @@ public:
             else if (pos._ptr->prev->prev != head){ //specially dealing with the first block
                 _Block *b = tail->prev;
                 if (b->len >= MAXS) {
-                    b->_split(MAXS / 2);
+                    b->_split(MAXS / 2, *this);
                     b = b->next;
                 }
                 new (b->data + b->len) T(value);
@@ -988,7 +1039,7 @@ public:
     //erase the element at pos
     //return the iterator point to the next element
 	iterator erase(iterator pos) {
-        if (pos._container != this || pos._ptr == nullptr || pos._ptr == tail)
+        if (checked_access && (pos._container != this || pos._ptr == nullptr || pos._ptr == tail))
             throw invalid_iterator();
         if (_size == 0)
             throw container_is_empty();
@@ -1009,11 +1060,10 @@ public:
                 pos._pos = 0;
                 head->next = tail;
                 tail->prev = head;
-                b->_clear();
-                delete b;
+                _deleteBlock(b);
             }
             else
-                pos._ptr->_merge();
+                pos._ptr->_merge(*this);
         }
         --_size;
         if (pos._ptr == tail)
@@ -1039,11 +1089,11 @@ public:
 	void push_back(const T &value) {
         _Block *b = tail->prev;
         if (b == head || b->len >= MAXS) { //create a new block
-            b->next = new _Block(b, tail);
+            b->next = _newBlock(b, tail);
             b = b->next;
             b->prev->next = b;
             b->next->prev = b;
-            b->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+            b->data = _newData();
         }
         if (b != head->next) {
             new (b->data + b->len) T(value);
@@ -1075,12 +1125,11 @@ public:
         }
         --(b->len);
         --_size;
-        b->_merge();
+        b->_merge(*this);
         if (b->len == 0) { //if the block is empty
             b->prev->next = b->next;
             b->next->prev = b->prev;
-            b->_clear();
-            delete b;
+            _deleteBlock(b);
         }
     }
 	
@@ -1090,12 +1139,12 @@ public:
             new (head->next->data + head->next->len) T(value);
             ++(head->next->len);
             if (head->next->len >= MAXS)
-                head->next->_split(MAXS / 2);
+                head->next->_split(MAXS / 2, *this);
         }
         else { //if the container is empty
-            head->next = new _Block(head, tail);
+            head->next = _newBlock(head, tail);
             tail->prev = head->next;
-            head->next->data = (T *)malloc(sizeof(T) * (MAXS + 1));
+            head->next->data = _newData();
             new (head->next->data) T(value);
             head->next->len = 1;
         }
@@ -1109,14 +1158,85 @@ public:
         (b->data + b->len - 1)->~T();
         --(b->len);
         --_size;
-        b->_merge();
+        b->_merge(*this);
         if (b->len == 0) { //the block is empty
             b->prev->next = b->next;
             b->next->prev = b->prev;
-            b->_clear();
-            delete b;
+            _deleteBlock(b);
         }
     }
+
+    //write the elements to os or the file descriptor fd, see serialize.hpp
+    //trivially copyable elements are written a block at a time
+    void save(std::ostream &os) const {
+        binary_writer out(os);
+        save(out);
+    }
+    void save(int fd) const {
+        binary_writer out(fd);
+        save(out);
+        out.flush();
+    }
+    void save(binary_writer &out) const {
+        _save_header(out, serial_deque, sizeof(T), _serial_bulk<T>::value, _size);
+        for (_Block *b = head->next; b != tail; b = b->next)
+            _saveBlock(out, b, b == head->next, _serial_bulk<T>());
+    }
+    //replace the contents with the elements written by save()
+    //the blocks are filled up directly, trivially copyable elements are read a block at a time
+    //throw runtime_error if the input holds something else or ends early, leaving the deque empty
+    void load(std::istream &is) {
+        binary_reader in(is);
+        load(in);
+    }
+    void load(int fd) {
+        binary_reader in(fd);
+        load(in);
+    }
+    void load(binary_reader &in) {
+        clear();
+        size_type n = _load_header(in, serial_deque, sizeof(T), _serial_bulk<T>::value);
+        try {
+            _Block *b = head;
+            while (_size < n) {
+                //the first block holds a single element, so its reversed order does not matter
+                size_type m = (b == head ? 1 : (n - _size < MAXS ? n - _size : MAXS));
+                b->next = _newBlock(b, tail);
+                b = b->next;
+                tail->prev = b;
+                b->data = _newData();
+                _loadBlock(in, b, m, _serial_bulk<T>());
+                _size += m;
+            }
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+private:
+    //the first block keeps its elements in reverse
+    void _saveBlock(binary_writer &out, const _Block *b, bool first, std::true_type) const {
+        if (!first) {
+            out.write(b->data, sizeof(T) * b->len);
+            return;
+        }
+        for (size_type i = b->len; i > 0; --i)
+            out.write(b->data + i - 1, sizeof(T));
+    }
+    void _saveBlock(binary_writer &out, const _Block *b, bool first, std::false_type) const {
+        for (size_type i = 0; i < b->len; ++i)
+            serializer<T>::save(out, *(b->data + (first ? b->len - 1 - i : i)));
+    }
+    void _loadBlock(binary_reader &in, _Block *b, size_type m, std::true_type) {
+        in.read(b->data, sizeof(T) * m);
+        b->len = m;
+    }
+    void _loadBlock(binary_reader &in, _Block *b, size_type m, std::false_type) {
+        for (; b->len < m; ++b->len)
+            new (b->data + b->len) T(serializer<T>::load(in));
+    }
 };
 //----------end of class deque----------
 }
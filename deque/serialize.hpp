@@ -0,0 +1,262 @@
+#ifndef SJTU_SERIALIZE_HPP
+#define SJTU_SERIALIZE_HPP
+
+#include "exceptions.hpp"
+#include "utility.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+
+namespace sjtu {
+
+/**
+ * binary serialization of sjtu containers, see save() and load() of the containers.
+ * a saved container is a header of 32 bytes followed by its elements:
+ *     char magic[8];       "SJTUSER"
+ *     uint32_t version;    1
+ *     uint32_t kind;       which container wrote it
+ *     uint32_t elem_size;  sizeof the element type
+ *     uint32_t flags;      bit 0: the elements are raw bytes
+ *     uint64_t count;      the number of elements
+ * everything is in the byte order of the machine which wrote it.
+ * loading throws runtime_error if the header does not match or the input ends early.
+ */
+enum serial_kind : uint32_t {
+    serial_vector = 1,
+    serial_deque = 2,
+    serial_map = 3,
+    serial_priority_queue = 4
+};
+
+/**
+ * where the bytes go: an std::ostream, or a file descriptor written through a buffer
+ */
+class binary_writer {
+    static constexpr size_t BUF = 1 << 16;
+
+    std::ostream *_os = nullptr;
+    int _fd = -1;
+    char *_buf = nullptr;
+    size_t _len = 0;
+
+public:
+    explicit binary_writer(std::ostream &os) : _os(&os) {}
+    explicit binary_writer(int fd) : _fd(fd), _buf(new char[BUF]) {}
+    binary_writer(const binary_writer &) = delete;
+    binary_writer &operator =(const binary_writer &) = delete;
+    //call flush() first to see the errors
+    ~binary_writer() {
+        try {
+            flush();
+        }
+        catch (...) {}
+        delete[] _buf;
+    }
+
+    //large blocks skip the buffer
+    void write(const void *p, size_t n) {
+        if (_os != nullptr) {
+            if (!_os->write((const char *)p, (std::streamsize)n))
+                throw runtime_error();
+            return;
+        }
+        if (_len + n > BUF)
+            flush();
+        if (n >= BUF)
+            _write_fd((const char *)p, n);
+        else {
+            memcpy(_buf + _len, p, n);
+            _len += n;
+        }
+    }
+    void flush() {
+        if (_os != nullptr) {
+            if (!_os->flush())
+                throw runtime_error();
+            return;
+        }
+        size_t n = _len;
+        _len = 0;
+        _write_fd(_buf, n);
+    }
+
+private:
+    void _write_fd(const char *p, size_t n) {
+        while (n > 0) {
+            ssize_t k = ::write(_fd, p, n);
+            if (k < 0 && errno == EINTR)
+                continue;
+            if (k <= 0)
+                throw runtime_error();
+            p += k;
+            n -= (size_t)k;
+        }
+    }
+};
+
+/**
+ * where the bytes come from: an std::istream, or a file descriptor read through a buffer.
+ * the buffer reads ahead of the container being loaded;
+ * the destructor seeks the descriptor back to the end of what was used,
+ * which cannot be done on a pipe.
+ */
+class binary_reader {
+    static constexpr size_t BUF = 1 << 16;
+
+    std::istream *_is = nullptr;
+    int _fd = -1;
+    char *_buf = nullptr;
+    size_t _pos = 0, _len = 0;
+
+public:
+    explicit binary_reader(std::istream &is) : _is(&is) {}
+    explicit binary_reader(int fd) : _fd(fd), _buf(new char[BUF]) {}
+    binary_reader(const binary_reader &) = delete;
+    binary_reader &operator =(const binary_reader &) = delete;
+    ~binary_reader() {
+        if (_len > _pos)
+            lseek(_fd, -(off_t)(_len - _pos), SEEK_CUR);
+        delete[] _buf;
+    }
+
+    //large blocks skip the buffer
+    void read(void *p, size_t n) {
+        if (_is != nullptr) {
+            if (!_is->read((char *)p, (std::streamsize)n))
+                throw runtime_error();
+            return;
+        }
+        char *q = (char *)p;
+        size_t k = _len - _pos < n ? _len - _pos : n;
+        memcpy(q, _buf + _pos, k);
+        _pos += k;
+        q += k;
+        n -= k;
+        if (n == 0)
+            return;
+        if (n >= BUF) {
+            _read_fd(q, n, n);
+            return;
+        }
+        _len = _read_fd(_buf, n, BUF);
+        memcpy(q, _buf, n);
+        _pos = n;
+    }
+
+private:
+    //read at least n and at most cap bytes
+    size_t _read_fd(char *p, size_t n, size_t cap) {
+        size_t got = 0;
+        while (got < n) {
+            ssize_t k = ::read(_fd, p + got, cap - got);
+            if (k < 0 && errno == EINTR)
+                continue;
+            if (k <= 0)
+                throw runtime_error();
+            got += (size_t)k;
+        }
+        return got;
+    }
+};
+
+/**
+ * the customization point: how one element is saved and loaded.
+ * specialize it for your own types as
+ *     template<> struct serializer<X> {
+ *         static void save(binary_writer &out, const X &value);
+ *         static X load(binary_reader &in);
+ *     };
+ * trivially copyable types are saved as their bytes, and the containers
+ * write and read a whole array of them at once.
+ * std::string and sjtu::pair are provided here, the containers provide their own.
+ */
+template<class T, class = void>
+struct serializer {
+    static_assert(!std::is_same<T, T>::value, "specialize sjtu::serializer<T> to save and load T");
+};
+
+template<class T>
+struct serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type> {
+    static constexpr bool bulk = true;
+    static void save(binary_writer &out, const T &value) {
+        out.write(&value, sizeof(T));
+    }
+    static T load(binary_reader &in) {
+        alignas(T) unsigned char buf[sizeof(T)];
+        in.read(buf, sizeof(T));
+        return *(T *)buf;
+    }
+};
+
+template<>
+struct serializer<std::string> {
+    static void save(binary_writer &out, const std::string &value) {
+        uint64_t n = value.size();
+        out.write(&n, sizeof(n));
+        out.write(value.data(), value.size());
+    }
+    static std::string load(binary_reader &in) {
+        uint64_t n;
+        in.read(&n, sizeof(n));
+        std::string value(n, '\0');
+        if (n > 0)
+            in.read(&value[0], n);
+        return value;
+    }
+};
+
+template<class T1, class T2>
+struct serializer<pair<T1, T2>, typename std::enable_if<!std::is_trivially_copyable<pair<T1, T2>>::value>::type> {
+    static void save(binary_writer &out, const pair<T1, T2> &value) {
+        serializer<typename std::remove_const<T1>::type>::save(out, value.first);
+        serializer<typename std::remove_const<T2>::type>::save(out, value.second);
+    }
+    static pair<T1, T2> load(binary_reader &in) {
+        typename std::remove_const<T1>::type first = serializer<typename std::remove_const<T1>::type>::load(in);
+        return pair<T1, T2>(std::move(first), serializer<typename std::remove_const<T2>::type>::load(in));
+    }
+};
+
+//whether the elements are saved as one array of raw bytes
+template<class T, class = void>
+struct _serial_bulk : std::false_type {};
+template<class T>
+struct _serial_bulk<T, typename std::enable_if<serializer<T>::bulk>::type> : std::true_type {};
+
+inline void _save_header(binary_writer &out, uint32_t kind, uint32_t elem_size, bool bulk, uint64_t count) {
+    char h[32] = "SJTUSER";
+    uint32_t fields[4] = {1, kind, elem_size, bulk ? 1u : 0u};
+    memcpy(h + 8, fields, sizeof(fields));
+    memcpy(h + 24, &count, sizeof(count));
+    out.write(h, sizeof(h));
+}
+//the count of the elements following a header which must match the arguments
+inline uint64_t _load_header(binary_reader &in, uint32_t kind, uint32_t elem_size, bool bulk) {
+    char h[32];
+    in.read(h, sizeof(h));
+    uint32_t fields[4];
+    memcpy(fields, h + 8, sizeof(fields));
+    if (memcmp(h, "SJTUSER", 8) != 0 || fields[0] != 1 || fields[1] != kind || fields[2] != elem_size
+        || fields[3] != (bulk ? 1u : 0u))
+        throw runtime_error();
+    uint64_t count;
+    memcpy(&count, h + 24, sizeof(count));
+    //no memory holds more, and sizing the storage for them would overflow;
+    //elem_size 0 is a packed vector<bool>, whose count is rounded up to whole words
+    uint64_t most = elem_size == 0 ? (uint64_t)SIZE_MAX - 64 : (uint64_t)SIZE_MAX / elem_size;
+    if (count > most)
+        throw runtime_error();
+    return count;
+}
+
+}
+
+#endif
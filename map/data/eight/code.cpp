@@ -0,0 +1,91 @@
+#include "map.hpp"
+
+#include <iostream>
+#include <string>
+
+typedef sjtu::pair<const int, std::string> Value;
+typedef sjtu::map<int, std::string, std::less<int>, sjtu::pool_allocator<Value>> PoolMap;
+typedef sjtu::map<int, int, std::less<int>, sjtu::arena_allocator<sjtu::pair<const int, int>>> ArenaMap;
+
+void TestPool()
+{
+	std::cout << "Testing pool allocator..." << std::endl;
+	PoolMap m;
+	for (int i = 0; i < 10000; ++i) {
+		m[i * 7 % 10007] = std::to_string(i);
+	}
+	for (int i = 0; i < 5000; ++i) {
+		m.erase(m.find(i * 7 % 10007));
+	}
+	for (int i = 0; i < 2000; ++i) {
+		m.insert(Value(i * 7 % 10007, "again"));
+	}
+	PoolMap copy(m);
+	m.clear();
+	std::cout << m.size() << " " << copy.size() << std::endl;
+	m = copy;
+	int cnt = 0;
+	for (PoolMap::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		if (it->second == "again") {
+			++cnt;
+		}
+	}
+	std::cout << m.size() << " " << cnt << " " << m.cbegin()->first << " " << m.at(7) << std::endl;
+}
+
+void TestPoolCopies()
+{
+	std::cout << "Testing pool allocator copies..." << std::endl;
+	sjtu::pool_allocator<int> *a = new sjtu::pool_allocator<int>();
+	int *p = a->allocate(1);
+	*p = 42;
+	//a copy shares the pool, so it can free the slot after the original is gone
+	sjtu::pool_allocator<int> b(*a), c;
+	std::cout << (b == *a) << " " << (c == *a) << std::endl;
+	delete a;
+	std::cout << *p << std::endl;
+	b.deallocate(p, 1);
+	c = b;
+	std::cout << (c == b) << " " << (c.allocate(1) == p) << std::endl;
+	PoolMap m;
+	m[1] = "one";
+	PoolMap n(m);
+	m.clear();
+	std::cout << n.size() << " " << n.at(1) << std::endl;
+}
+
+void TestArena()
+{
+	std::cout << "Testing arena allocator..." << std::endl;
+	char buffer[4096];
+	sjtu::monotonic_arena arena(buffer, sizeof(buffer));
+	for (int round = 0; round < 3; ++round) {
+		{
+			ArenaMap m{sjtu::arena_allocator<sjtu::pair<const int, int>>(arena)};
+			for (int i = 0; i < 1000; ++i) {
+				m[i] = i * round;
+			}
+			long long sum = 0;
+			for (ArenaMap::iterator it = m.begin(); it != m.end(); ++it) {
+				sum += it->second;
+			}
+			std::cout << m.size() << " " << sum << std::endl;
+		}
+		arena.release();
+	}
+	//a chunk size of 0 still grows
+	sjtu::monotonic_arena empty(0);
+	ArenaMap m{sjtu::arena_allocator<sjtu::pair<const int, int>>(empty)};
+	for (int i = 0; i < 100; ++i) {
+		m[i] = i;
+	}
+	std::cout << m.size() << " " << m.at(99) << std::endl;
+}
+
+int main()
+{
+	TestPool();
+	TestPoolCopies();
+	TestArena();
+	return 0;
+}
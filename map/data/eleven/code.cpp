@@ -0,0 +1,37 @@
+#define SJTU_UNCHECKED
+#include "map.hpp"
+
+#include <iostream>
+#include <string>
+
+typedef sjtu::map<int, std::string> Map;
+
+static_assert(!sjtu::checked_access, "unchecked");
+static_assert(sizeof(Map::iterator) == sizeof(void *), "bare iterator");
+static_assert(sizeof(Map::const_iterator) == sizeof(void *), "bare const_iterator");
+
+int main()
+{
+	std::cout << "Testing unchecked..." << std::endl;
+	Map m;
+	for (int i = 0; i < 100; ++i) {
+		m[(i * 37) % 100] = std::to_string(i);
+	}
+	for (int i = 0; i < 100; i += 2) {
+		m.erase(m.find(i));
+	}
+	int keys = 0;
+	for (Map::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		keys += it->first;
+	}
+	Map::iterator last = m.end();
+	--last;
+	std::cout << m.size() << " " << keys << " " << m.begin()->first << " " << last->first << " " << m[37] << std::endl;
+	const Map &cm = m;
+	try {
+		cm.at(2);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at is checked" << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include "map.hpp"
+
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+
+int countdown = -1;
+
+//fails the countdown-th allocation from now on
+template <class T>
+struct FailingAlloc {
+	using value_type = T;
+	FailingAlloc() {}
+	template <class U>
+	FailingAlloc(const FailingAlloc<U> &) {}
+	T *allocate(size_t n) {
+		if (countdown >= 0 && countdown-- == 0)
+			throw std::bad_alloc();
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T *p, size_t n) {
+		std::allocator<T>().deallocate(p, n);
+	}
+	bool operator ==(const FailingAlloc &) const {
+		return true;
+	}
+	bool operator !=(const FailingAlloc &) const {
+		return false;
+	}
+};
+
+void TestSaveLoad()
+{
+	std::cout << "Testing save and load..." << std::endl;
+	sjtu::map<int, std::string> a;
+	for (int i = 0; i < 10000; ++i) {
+		a[i * 7 % 10007] = std::to_string(i);
+	}
+	sjtu::map<int, long long> b;
+	for (int i = 0; i < 100000; ++i) {
+		b[i * 3] = (long long)i * i;
+	}
+	std::stringstream ss;
+	a.save(ss);
+	b.save(ss);
+	sjtu::map<int, std::string> a2;
+	a2[-1] = "gone";
+	sjtu::map<int, long long> b2;
+	a2.load(ss);
+	b2.load(ss);
+	bool ok = a2.size() == a.size() && b2.size() == b.size() && a2.count(-1) == 0;
+	sjtu::map<int, std::string>::const_iterator i1 = a.cbegin(), i2 = a2.cbegin();
+	for (; i1 != a.cend(); ++i1, ++i2) {
+		ok = ok && i1->first == i2->first && i1->second == i2->second;
+	}
+	std::cout << ok << " " << b2.at(299997) << " " << a2.cbegin()->second << std::endl;
+	//the loaded map works as any other
+	for (int i = 0; i < 10007; i += 2) {
+		sjtu::map<int, std::string>::iterator it = a2.find(i);
+		if (it != a2.end()) {
+			a2.erase(it);
+		}
+	}
+	for (int i = 0; i < 1000; ++i) {
+		a2[20000 + i] = "new";
+	}
+	int n = 0;
+	for (sjtu::map<int, std::string>::const_iterator it = a2.cbegin(); it != a2.cend(); ++it) {
+		++n;
+	}
+	std::cout << a2.size() << " " << n << " " << a2.at(20999) << std::endl;
+	//keys out of order for this Compare are refused
+	std::stringstream tt;
+	b.save(tt);
+	sjtu::map<int, long long, std::greater<int>> c;
+	try {
+		c.load(tt);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "out of order " << c.size() << std::endl;
+	}
+}
+
+void TestFailedLoad()
+{
+	std::cout << "Testing failed load..." << std::endl;
+	typedef sjtu::map<int, std::string, std::less<int>, FailingAlloc<sjtu::pair<const int, std::string>>> Map;
+	Map a;
+	for (int i = 0; i < 20; ++i) {
+		a[i] = std::to_string(i);
+	}
+	std::stringstream ss;
+	a.save(ss);
+	std::string saved = ss.str();
+	int failed = 0, loaded = 0;
+	//every allocation of the load fails in turn, a tree node and then its list node
+	for (int k = 0; k < 45; ++k) {
+		Map b;
+		std::stringstream in(saved);
+		countdown = k;
+		try {
+			b.load(in);
+		} catch (std::bad_alloc &) {
+			++failed;
+			if (b.size() != 0 || b.begin() != b.end()) {
+				std::cout << "not empty" << std::endl;
+			}
+		}
+		countdown = -1;
+		loaded += b.size() == a.size();
+	}
+	std::cout << failed << " " << loaded << std::endl;
+}
+
+int main()
+{
+	TestSaveLoad();
+	TestFailedLoad();
+	return 0;
+}
@@ -0,0 +1,22 @@
+#define SJTU_STATS
+#include "map.hpp"
+
+#include <iostream>
+
+int main()
+{
+	std::cout << "Testing stats..." << std::endl;
+	sjtu::map<int, int> a;
+	for (int i = 0; i < 1000; ++i) {
+		a[i] = i;
+	}
+	sjtu::map<int, int>::stats_type s = a.stats();
+	std::cout << s.rotations << " " << s.node_allocations << " " << s.successor_copies << std::endl;
+	a.reset_stats();
+	for (int i = 0; i < 1000; i += 3) {
+		a.erase(a.find(i));
+	}
+	s = a.stats();
+	std::cout << s.rotations << " " << s.node_allocations << " " << s.successor_copies << std::endl;
+	return 0;
+}
@@ -7,15 +7,25 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "allocator.hpp"
+#include "serialize.hpp"
 
 namespace sjtu {
 
+/**
+ * tree nodes and list nodes are allocated by Alloc rebound to the node types,
+ * see allocator.hpp.
+ */
 template<
 	class Key,
 	class T,
-	class Compare = std::less<Key>
+	class Compare = std::less<Key>,
+	class Alloc = allocator<pair<const Key, T>>
 >
 class map {
 public:
@@ -32,6 +42,18 @@ public:
 	using key_compare   = Compare;
 	using size_type     = size_t;
 
+    /**
+     * what the map has done inside, counted only if SJTU_STATS is defined.
+     * node_allocations counts both the tree nodes and the list nodes,
+     * successor_copies the erasures of a node with two children,
+     * which copy the successor's element into a new node.
+     */
+    struct stats_type{
+        size_t rotations = 0;
+        size_t node_allocations = 0;
+        size_t successor_copies = 0;
+    };
+
 protected:
     //basic structs of Red-black Tree
     enum Colour {RED, BLACK};
@@ -61,11 +83,39 @@ protected:
             prev(t.prev), succ(t.succ), tn(t.tn) {}
     };
 
+protected:
+    //allocation of nodes
+    using _TreeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_TreeNode>;
+    using _ListAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_ListNode>;
+
+    template<class... Args>
+    _TreeNode *_newTree(Args&&... args){
+        SJTU_STAT(++_stats.node_allocations);
+        _TreeNode *x = _tree_alloc.allocate(1);
+        new (x) _TreeNode(std::forward<Args>(args)...);
+        return x;
+    }
+    void _deleteTree(_TreeNode *x){
+        x->~_TreeNode();
+        _tree_alloc.deallocate(x, 1);
+    }
+    _ListNode *_newList(){
+        SJTU_STAT(++_stats.node_allocations);
+        _ListNode *x = _list_alloc.allocate(1);
+        new (x) _ListNode();
+        return x;
+    }
+    void _deleteList(_ListNode *x){
+        x->~_ListNode();
+        _list_alloc.deallocate(x, 1);
+    }
+
 protected:
     //inner functions of Red-black Tree
     void _leftRotate(_TreeNode *p){
         if (p == nullptr)
             return;
+        SJTU_STAT(++_stats.rotations);
         _TreeNode *r = p->r;
         p->r = r->l;
         if (r->l != nullptr)
@@ -83,6 +133,7 @@ protected:
     void _rightRotate(_TreeNode *p){
         if (p == nullptr)
             return;
+        SJTU_STAT(++_stats.rotations);
         _TreeNode *l = p->l;
         p->l = l->r;
         if (l->r != nullptr)
@@ -207,7 +258,7 @@ protected:
     void _copy(_TreeNode *x, _TreeNode *y, _TreeNode *p = nullptr, int c = 0){
         if (y == nullptr)
             return;
-        x = new _TreeNode(y->key);
+        x = _newTree(y->key);
         x->colour = y->colour;
         x->p = p;
         if (p == nullptr)
@@ -226,7 +277,7 @@ protected:
         if (x->l != nullptr){
             p = _buildList(x->l, p);
         }
-        p->succ = new _ListNode();
+        p->succ = _newList();
         p->succ->prev = p;
         p = p->succ;
         p->tn = x;
@@ -289,9 +340,9 @@ protected:
     bool _insert(const value_type &x){
         _TreeNode *t = root;
         if (t == nullptr){
-            root = new _TreeNode(x);
+            root = _newTree(x);
             root->colour = BLACK;
-            _ListNode *p = new _ListNode();
+            _ListNode *p = _newList();
             root->ln = p;
             p->tn = root;
             p->prev = head;
@@ -316,13 +367,13 @@ protected:
             else
                 return false;
         } while (t != nullptr);
-        _TreeNode *e = new _TreeNode(x, p);
+        _TreeNode *e = _newTree(x, p);
         if (cmp == -1)
             p->l = e;
         else
             p->r = e;
         _TreeNode *pr = _prev(e);
-        _ListNode *pp = new _ListNode(), *q;
+        _ListNode *pp = _newList(), *q;
         if (pr == nullptr)
             q = head;
         else
@@ -345,7 +396,8 @@ protected:
         _ListNode *tt = p->ln;
         if (p->l != nullptr && p->r != nullptr){
             _TreeNode *s = _succ(p);
-            _TreeNode *pp = new _TreeNode(*s);
+            SJTU_STAT(++_stats.successor_copies);
+            _TreeNode *pp = _newTree(*s);
             pp->colour = p->colour;
             pp->ln->tn = pp;
             pp->p = p->p;
@@ -363,12 +415,12 @@ protected:
             pp->r = p->r;
             if (p->r != nullptr)
                 p->r->p = pp;
-            delete p;
+            _deleteTree(p);
             p = s;
         }
         tt->prev->succ = tt->succ;
         tt->succ->prev = tt->prev;
-        delete tt;
+        _deleteList(tt);
         tt = nullptr;
         _TreeNode *t = (p->l != nullptr ? p->l : p->r);
         if (t != nullptr){
@@ -396,7 +448,7 @@ protected:
                 p->p = nullptr;
             }
         }
-        delete p;
+        _deleteTree(p);
         p = nullptr;
         --_size;
     }
@@ -408,23 +460,28 @@ protected:
             _disposeTree(x->l);
         if (x->r != nullptr)
             _disposeTree(x->r);
-        delete x;
+        _deleteTree(x);
     }
     void _disposeList() {
         _ListNode *p = head, *q;
         while (p != tail) {
             q = p->succ;
-            delete p;
+            _deleteList(p);
             p = q;
         }
-        delete tail;
+        _deleteList(tail);
         head = tail = nullptr;
     }
 
 protected:
     //inner members of map
+#ifdef SJTU_STATS
+    stats_type _stats;
+#endif
+    _TreeAlloc _tree_alloc;
+    _ListAlloc _list_alloc;
     _TreeNode *root = nullptr;
-    _ListNode *head = new _ListNode(), *tail = new _ListNode();
+    _ListNode *head = _newList(), *tail = _newList();
     size_type _size = 0;
 
 public:
@@ -437,37 +494,49 @@ public:
         using difference_type   = ptrdiff_t;
 	private:
         _ListNode *_ptr;
+#ifndef SJTU_UNCHECKED
 		map *_container;
+		map *_owner() const {
+            return _container;
+		}
 	public:
 		iterator(_ListNode *_p = nullptr, map *_c = nullptr) :
 		    _ptr(_p), _container(_c) {}
-		iterator(const iterator &other) :
-		    _ptr(other._ptr), _container(other._container) {}
+#else
+		map *_owner() const {
+            return nullptr;
+		}
+	public:
+		iterator(_ListNode *_p = nullptr, map * = nullptr) :
+		    _ptr(_p) {}
+#endif
+		iterator(const iterator &other) = default;
         iterator(const const_iterator &other) :
-		    _ptr(other._ptr), _container(other._container) {}
+		    iterator(other._ptr, const_cast<map *>(other._owner())) {}
+		iterator &operator =(const iterator &other) = default;
 
 		iterator operator ++(int) {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _owner()->tail)
                 throw invalid_iterator();
             _ListNode *_p = _ptr;
             _ptr = _ptr->succ;
-            return iterator(_p, _container);
+            return iterator(_p, _owner());
 		}
 		iterator &operator ++() {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _owner()->tail)
                 throw invalid_iterator();
             _ptr = _ptr->succ;
             return *this;
 		}
 		iterator operator --(int) {
-            if (_ptr == _container->head->succ)
+            if (checked_access && _ptr == _owner()->head->succ)
                 throw invalid_iterator();
             _ListNode *_p = _ptr;
             _ptr = _ptr->prev;
-            return iterator(_p, _container);
+            return iterator(_p, _owner());
 		}
 		iterator &operator --() {
-            if (_ptr == _container->head->succ)
+            if (checked_access && _ptr == _owner()->head->succ)
                 throw invalid_iterator();
             _ptr = _ptr->prev;
             return *this;
@@ -503,39 +572,51 @@ public:
         using difference_type   = ptrdiff_t;
 	private:
         _ListNode *_ptr;
+#ifndef SJTU_UNCHECKED
 		const map *_container;
+		const map *_owner() const {
+            return _container;
+		}
     public:
 		const_iterator(_ListNode *_p = nullptr, const map *_c = nullptr) :
 		    _ptr(_p), _container(_c) {}
+#else
+		const map *_owner() const {
+            return nullptr;
+		}
+    public:
+		const_iterator(_ListNode *_p = nullptr, const map * = nullptr) :
+		    _ptr(_p) {}
+#endif
         const_iterator(_ListNode *_p, map *_c) :
-		    _ptr(_p), _container(const_cast<const map *>(_c)) {}
+		    const_iterator(_p, const_cast<const map *>(_c)) {}
 		const_iterator(const iterator &other) :
-		    _ptr(other._ptr), _container(other._container) {}
-        const_iterator(const const_iterator &other) :
-		    _ptr(other._ptr), _container(other._container) {}
+		    const_iterator(other._ptr, other._owner()) {}
+        const_iterator(const const_iterator &other) = default;
+		const_iterator &operator =(const const_iterator &other) = default;
 
 		const_iterator operator ++(int) {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _owner()->tail)
                 throw invalid_iterator();
             _ListNode *_p = _ptr;
             _ptr = _ptr->succ;
-            return const_iterator(_p, _container);
+            return const_iterator(_p, _owner());
 		}
 		const_iterator &operator ++() {
-            if (_ptr == _container->tail)
+            if (checked_access && _ptr == _owner()->tail)
                 throw invalid_iterator();
             _ptr = _ptr->succ;
             return *this;
 		}
 		const_iterator operator --(int) {
-            if (_ptr == _container->head->succ)
+            if (checked_access && _ptr == _owner()->head->succ)
                 throw invalid_iterator();
             _ListNode *_p = _ptr;
             _ptr = _ptr->prev;
-            return const_iterator(_p, _container);
+            return const_iterator(_p, _owner());
 		}
 		const_iterator &operator --() {
-            if (_ptr == _container->head->succ)
+            if (checked_access && _ptr == _owner()->head->succ)
                 throw invalid_iterator();
             _ptr = _ptr->prev;
             return *this;
@@ -568,7 +649,11 @@ public:
         head->succ = tail;
         tail->prev = tail;
 	}
-	map(const map &other) {
+	explicit map(const Alloc &alloc) : _tree_alloc(alloc), _list_alloc(alloc) {
+        head->succ = tail;
+        tail->prev = head;
+	}
+	map(const map &other) : _tree_alloc(other._tree_alloc), _list_alloc(other._list_alloc) {
         if (other.root != nullptr) {
             _copy(root, other.root);
             _ListNode *p = head;
@@ -591,16 +676,16 @@ public:
         _disposeList();
         if (other.root != nullptr) {
             _copy(root, other.root);
-            head = new _ListNode();
+            head = _newList();
             _ListNode *p = head;
             p = _buildList(root, p);
-            tail = new _ListNode();
+            tail = _newList();
             p->succ = tail;
             tail->prev = p;
         }
         else {
-            head = new _ListNode();
-            tail = new _ListNode();
+            head = _newList();
+            tail = _newList();
             head->succ = tail;
             tail->prev = head;
         }
@@ -659,17 +744,30 @@ public:
         return root == nullptr;
 	}
 
+	stats_type stats() const {
+#ifdef SJTU_STATS
+        return _stats;
+#else
+        return stats_type();
+#endif
+	}
+	void reset_stats() {
+        SJTU_STAT(_stats = stats_type());
+	}
+
 	size_type size() const {
         return _size;
 	}
 
+	//head and tail are kept, so clear() never allocates and load() can always start empty
 	void clear() {
         _disposeTree(root);
         root = nullptr;
         _size = 0;
-        _disposeList();
-        head = new _ListNode();
-        tail = new _ListNode();
+        for (_ListNode *p = head->succ, *q; p != tail; p = q) {
+            q = p->succ;
+            _deleteList(p);
+        }
         head->succ = tail;
         tail->prev = head;
 	}
@@ -681,7 +779,7 @@ public:
 	}
 
 	void erase(iterator pos) {
-        if (pos._container != this || pos._ptr == tail)
+        if (checked_access && (pos._owner() != this || pos._ptr == tail))
             throw invalid_iterator();
         _remove(pos->first);
 	}
@@ -702,6 +800,97 @@ public:
             return const_iterator(tail, this);
         return const_iterator(p->ln, this);
 	}
+
+	//write the elements in order to os or the file descriptor fd, see serialize.hpp
+	void save(std::ostream &os) const {
+        binary_writer out(os);
+        save(out);
+	}
+	void save(int fd) const {
+        binary_writer out(fd);
+        save(out);
+        out.flush();
+	}
+	void save(binary_writer &out) const {
+        _save_header(out, serial_map, sizeof(value_type), _serial_bulk<value_type>::value, _size);
+        for (_ListNode *p = head->succ; p != tail; p = p->succ)
+            serializer<value_type>::save(out, p->tn->key);
+	}
+	//replace the contents with the elements written by save()
+	//as they come in order, the tree is built balanced in O(n) without any rotation
+	//throw runtime_error if the input holds something else, ends early
+	//or is not in increasing order by Compare, leaving the map empty
+	void load(std::istream &is) {
+        binary_reader in(is);
+        load(in);
+	}
+	void load(int fd) {
+        binary_reader in(fd);
+        load(in);
+	}
+	void load(binary_reader &in) {
+        clear();
+        size_type n = _load_header(in, serial_map, sizeof(value_type), _serial_bulk<value_type>::value);
+        //the levels above h are full and black, the nodes below them are red
+        size_type h = 0;
+        while (((size_type)2 << h) - 1 <= n)
+            ++h;
+        _ListNode *last = head;
+        try {
+            root = _loadTree(in, n, 0, h, last);
+        }
+        catch (...) {
+            //every node made so far is on the list
+            for (_ListNode *p = head->succ; p != tail && p != nullptr; ) {
+                _ListNode *q = p->succ;
+                _deleteTree(p->tn);
+                _deleteList(p);
+                p = q;
+            }
+            root = nullptr;
+            head->succ = tail;
+            tail->prev = head;
+            throw;
+        }
+        last->succ = tail;
+        tail->prev = last;
+        _size = n;
+	}
+
+protected:
+    //a balanced tree of the next n elements, whose list nodes are linked after last
+    _TreeNode *_loadTree(binary_reader &in, size_type n, size_type depth, size_type h, _ListNode *&last){
+        if (n == 0)
+            return nullptr;
+        _TreeNode *l = _loadTree(in, n / 2, depth + 1, h, last);
+        _TreeNode *x = _newTree(serializer<value_type>::load(in));
+        if (last != head && !comp(last->tn->key.first, x->key.first)){
+            _deleteTree(x);
+            throw runtime_error();
+        }
+        x->colour = (depth < h ? BLACK : RED);
+        _ListNode *p;
+        try {
+            p = _newList();
+        }
+        catch (...) {
+            //x is not on the list yet
+            _deleteTree(x);
+            throw;
+        }
+        p->prev = last;
+        last->succ = p;
+        p->tn = x;
+        x->ln = p;
+        last = p;
+        x->l = l;
+        if (l != nullptr)
+            l->p = x;
+        x->r = _loadTree(in, n - n / 2 - 1, depth + 1, h, last);
+        if (x->r != nullptr)
+            x->r->p = x;
+        return x;
+    }
 };
 
 }
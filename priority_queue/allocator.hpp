@@ -0,0 +1,382 @@
+#ifndef SJTU_ALLOCATOR_HPP
+#define SJTU_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+//blocks of this many bytes or more are mapped by the default allocator, 0 turns it off
+#ifndef SJTU_MMAP_THRESHOLD
+#define SJTU_MMAP_THRESHOLD (1 << 20)
+#endif
+
+namespace sjtu {
+
+/**
+ * the default allocator of sjtu containers.
+ * it gets raw memory from malloc/free, so blocks holding trivially relocatable
+ * elements can be resized by realloc.
+ * on linux blocks of SJTU_MMAP_THRESHOLD bytes or more are mapped from the kernel instead,
+ * and resized by mremap, which moves page table entries rather than bytes:
+ * doubling a vector of 4 GB copies nothing and never holds the old and the new block at once.
+ * deallocate() and reallocate() tell the mapped blocks by the size they are given,
+ * so it must be the size the block was allocated with.
+ *
+ * an allocator of sjtu containers provides
+ *     T *allocate(size_t n);
+ *     void deallocate(T *p, size_t n);
+ *     bool operator ==(const allocator &) const;
+ * and optionally
+ *     T *reallocate(T *p, size_t n, size_t cap);
+ * which resizes the block p of n elements to cap elements, keeping its bytes.
+ * node based containers rebind it to their node types.
+ * std::allocator meets it as well.
+ */
+template<class T>
+class allocator {
+public:
+    using value_type    = T;
+    using pointer       = T *;
+    using size_type     = size_t;
+
+    template<class U>
+    struct rebind {
+        using other = allocator<U>;
+    };
+
+    allocator() = default;
+    template<class U>
+    allocator(const allocator<U> &) {}
+
+    T *allocate(size_type n) {
+        if (n > (size_type)-1 / sizeof(T))
+            throw std::bad_alloc();
+        if (_mapped(n))
+            return (T *)_map(sizeof(T) * n);
+        T *p = (T *)malloc(sizeof(T) * n);
+        if (p == nullptr && n != 0)
+            throw std::bad_alloc();
+        return p;
+    }
+    void deallocate(T *p, size_type n) {
+        if (_mapped(n))
+            _unmap(p, sizeof(T) * n);
+        else
+            free((void *)p);
+    }
+    //a block crossing the threshold is copied between the heap and a mapping
+    T *reallocate(T *p, size_type n, size_type cap) {
+        if (p == nullptr)
+            return allocate(cap);
+        if (cap > (size_type)-1 / sizeof(T))
+            throw std::bad_alloc();
+        if (!_mapped(n) && !_mapped(cap)) {
+            T *q = (T *)realloc((void *)p, sizeof(T) * cap);
+            //the block p is left as it was
+            if (q == nullptr && cap != 0)
+                throw std::bad_alloc();
+            return q;
+        }
+#ifdef __linux__
+        if (_mapped(n) && _mapped(cap)) {
+            void *q = mremap((void *)p, sizeof(T) * n, sizeof(T) * cap, MREMAP_MAYMOVE);
+            if (q == MAP_FAILED)
+                throw std::bad_alloc();
+            return (T *)q;
+        }
+#endif
+        //allocate throws rather than dropping p
+        T *q = allocate(cap);
+        _copy((void *)q, (const void *)p, sizeof(T) * (n < cap ? n : cap));
+        deallocate(p, n);
+        return q;
+    }
+
+    bool operator ==(const allocator &) const {
+        return true;
+    }
+    bool operator !=(const allocator &) const {
+        return false;
+    }
+
+private:
+    static bool _mapped(size_type n) {
+#ifdef __linux__
+        return SJTU_MMAP_THRESHOLD > 0 && sizeof(T) * n >= (size_t)SJTU_MMAP_THRESHOLD;
+#else
+        (void)n;
+        return false;
+#endif
+    }
+    static void *_map(size_t bytes) {
+#ifdef __linux__
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        return p;
+#else
+        return malloc(bytes);
+#endif
+    }
+    //out of line, as inlined into reallocate gcc cannot tell which branch of allocate gave q
+    //and warns that a copy past the threshold overflows a heap block
+#ifdef __GNUC__
+    __attribute__((noinline))
+#endif
+    static void _copy(void *q, const void *p, size_t bytes) {
+        memcpy(q, p, bytes);
+    }
+    static void _unmap(void *p, size_t bytes) {
+#ifdef __linux__
+        munmap(p, bytes);
+#else
+        (void)bytes;
+        free(p);
+#endif
+    }
+};
+
+/**
+ * a monotonic arena.
+ * memory is carved out of chunks one piece after another and never freed one by one,
+ * all of it is given back at once by release() or the destructor.
+ * a caller-provided buffer can be used as the first chunk, e.g. an array on the stack.
+ * it is not thread-safe.
+ */
+class monotonic_arena {
+private:
+    struct _Chunk {
+        _Chunk *next;
+    };
+    _Chunk *_chunks = nullptr;
+    char *_cur = nullptr, *_end = nullptr;
+    char *_last = nullptr; //the latest allocation, which can grow in place
+    char *_buf = nullptr, *_buf_end = nullptr;
+    size_t _next_size;
+
+public:
+    explicit monotonic_arena(size_t chunk_size = 4096) : _next_size(chunk_size) {}
+    monotonic_arena(void *buf, size_t size, size_t chunk_size = 4096) :
+        _cur((char *)buf), _end((char *)buf + size), _buf((char *)buf), _buf_end((char *)buf + size),
+        _next_size(chunk_size) {}
+    monotonic_arena(const monotonic_arena &) = delete;
+    monotonic_arena &operator =(const monotonic_arena &) = delete;
+    ~monotonic_arena() {
+        release();
+    }
+
+    void *allocate(size_t bytes, size_t align) {
+        char *p = _align(_cur, align);
+        if (_cur == nullptr || p + bytes > _end) {
+            if (bytes > (size_t)-1 - align - sizeof(_Chunk))
+                throw std::bad_alloc();
+            //a request larger than the next chunk gets a chunk of its own size
+            size_t _size = _next_size < bytes + align ? bytes + align : _next_size;
+            _Chunk *c = (_Chunk *)malloc(sizeof(_Chunk) + _size);
+            if (c == nullptr)
+                throw std::bad_alloc();
+            c->next = _chunks;
+            _chunks = c;
+            _cur = (char *)(c + 1);
+            _end = _cur + _size;
+            _next_size = _size * 2;
+            p = _align(_cur, align);
+        }
+        _cur = p + bytes;
+        _last = p;
+        return p;
+    }
+    //grow the latest allocation p from old_bytes to bytes if the chunk has room
+    bool extend(void *p, size_t old_bytes, size_t bytes) {
+        if ((char *)p != _last || _cur != _last + old_bytes || _last + bytes > _end)
+            return false;
+        _cur = _last + bytes;
+        return true;
+    }
+    //give back all the memory, everything allocated from the arena is invalid afterwards
+    void release() {
+        while (_chunks != nullptr) {
+            _Chunk *c = _chunks;
+            _chunks = c->next;
+            free((void *)c);
+        }
+        _cur = _buf;
+        _end = _buf_end;
+        _last = nullptr;
+    }
+
+private:
+    static char *_align(char *p, size_t align) {
+        return (char *)(((size_t)p + align - 1) / align * align);
+    }
+};
+
+/**
+ * an allocator taking memory from a monotonic_arena.
+ * deallocate() does nothing, the memory comes back when the arena is released.
+ * a container using it must be constructed with the allocator and must not outlive the arena.
+ */
+template<class T>
+class arena_allocator {
+    template<class U>
+    friend class arena_allocator;
+
+public:
+    using value_type    = T;
+    using pointer       = T *;
+    using size_type     = size_t;
+
+    template<class U>
+    struct rebind {
+        using other = arena_allocator<U>;
+    };
+
+private:
+    monotonic_arena *_arena;
+
+public:
+    arena_allocator(monotonic_arena &arena) : _arena(&arena) {}
+    template<class U>
+    arena_allocator(const arena_allocator<U> &other) : _arena(other._arena) {}
+
+    T *allocate(size_type n) {
+        return (T *)_arena->allocate(sizeof(T) * n, alignof(T));
+    }
+    void deallocate(T *p, size_type n) {
+        (void)p;
+        (void)n;
+    }
+    T *reallocate(T *p, size_type n, size_type cap) {
+        if (p != nullptr && _arena->extend(p, sizeof(T) * n, sizeof(T) * cap))
+            return p;
+        T *q = allocate(cap);
+        if (p != nullptr)
+            memcpy((void *)q, (void *)p, sizeof(T) * (n < cap ? n : cap));
+        return q;
+    }
+
+    bool operator ==(const arena_allocator &other) const {
+        return _arena == other._arena;
+    }
+    bool operator !=(const arena_allocator &other) const {
+        return _arena != other._arena;
+    }
+};
+
+/**
+ * an allocator keeping a pool of slots of one element each, for node based containers.
+ * slots are carved out of chunks of ChunkSlots slots, so nodes allocated together stay
+ * close in memory, and freed slots are reused first.
+ * larger blocks come from malloc.
+ * copies share the pool and compare equal, so a container moved or copied along with
+ * its allocator can still free what it took over; the pool is given back when the last
+ * copy is destroyed. it is not thread-safe, nor are the containers sharing a pool.
+ * an allocator rebound to another type gets a pool of its own.
+ */
+template<class T, size_t ChunkSlots = 256>
+class pool_allocator {
+public:
+    using value_type    = T;
+    using pointer       = T *;
+    using size_type     = size_t;
+
+    template<class U>
+    struct rebind {
+        using other = pool_allocator<U, ChunkSlots>;
+    };
+
+private:
+    union _Slot {
+        _Slot *next;
+        alignas(T) unsigned char data[sizeof(T)];
+    };
+    struct _Chunk {
+        _Chunk *next;
+        _Slot slots[ChunkSlots];
+    };
+    struct _Pool {
+        size_type refs = 1;
+        _Chunk *chunks = nullptr;
+        _Slot *free = nullptr;
+        size_type used = ChunkSlots; //slots used in the latest chunk
+    };
+    _Pool *_pool;
+
+    //give up this copy's share of the pool, the last one frees it
+    void _release() {
+        _Pool *pool = _pool;
+        if (--pool->refs != 0)
+            return;
+        for (_Chunk *c = pool->chunks, *next; c != nullptr; c = next) {
+            next = c->next;
+            free((void *)c);
+        }
+        delete pool;
+    }
+
+public:
+    pool_allocator() : _pool(new _Pool()) {}
+    pool_allocator(const pool_allocator &other) : _pool(other._pool) {
+        ++_pool->refs;
+    }
+    template<class U>
+    pool_allocator(const pool_allocator<U, ChunkSlots> &) : _pool(new _Pool()) {}
+    pool_allocator &operator =(const pool_allocator &other) {
+        ++other._pool->refs;
+        _release();
+        _pool = other._pool;
+        return *this;
+    }
+    ~pool_allocator() {
+        _release();
+    }
+
+    T *allocate(size_type n) {
+        if (n != 1) {
+            T *p = (T *)malloc(sizeof(T) * n);
+            if (p == nullptr && n != 0)
+                throw std::bad_alloc();
+            return p;
+        }
+        if (_pool->free != nullptr) {
+            _Slot *s = _pool->free;
+            _pool->free = s->next;
+            return (T *)s;
+        }
+        if (_pool->used == ChunkSlots) {
+            _Chunk *c = (_Chunk *)malloc(sizeof(_Chunk));
+            if (c == nullptr)
+                throw std::bad_alloc();
+            c->next = _pool->chunks;
+            _pool->chunks = c;
+            _pool->used = 0;
+        }
+        return (T *)(_pool->chunks->slots + _pool->used++);
+    }
+    void deallocate(T *p, size_type n) {
+        if (n != 1) {
+            free((void *)p);
+            return;
+        }
+        _Slot *s = (_Slot *)p;
+        s->next = _pool->free;
+        _pool->free = s;
+    }
+
+    //the copies sharing a pool can free each other's slots
+    bool operator ==(const pool_allocator &other) const {
+        return _pool == other._pool;
+    }
+    bool operator !=(const pool_allocator &other) const {
+        return _pool != other._pool;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+#define SJTU_STATS
+#include "priority_queue.hpp"
+
+#include <iostream>
+
+int main()
+{
+	std::cout << "Testing stats..." << std::endl;
+	sjtu::priority_queue<int> a;
+	for (int i = 0; i < 1024; ++i) {
+		a.push(i * 37 % 1024);
+	}
+	std::cout << a.stats().merges << " " << a.stats().max_merge_depth << std::endl;
+	a.reset_stats();
+	while (!a.empty()) {
+		a.pop();
+	}
+	std::cout << a.stats().merges << " " << a.stats().last_merge_depth << " " << a.stats().max_merge_depth << std::endl;
+	sjtu::priority_queue<int> b, c;
+	for (int i = 0; i < 100; ++i) {
+		b.push(i);
+		c.push(-i);
+	}
+	b.merge(c);
+	std::cout << b.stats().merges << " " << b.stats().last_merge_depth << " " << b.size() << std::endl;
+	return 0;
+}
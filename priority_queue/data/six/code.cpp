@@ -0,0 +1,100 @@
+#include "priority_queue.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//a saved queue of n ints in one chain, each node having only the child given by link
+std::string Chain(int n, unsigned char link)
+{
+	sjtu::priority_queue<int> one;
+	one.push(0);
+	std::stringstream ss;
+	one.save(ss);
+	std::string s = ss.str().substr(0, 32);
+	uint64_t count = n;
+	memcpy(&s[24], &count, sizeof(count));
+	for (int i = 0; i < n; ++i) {
+		int v = n - i;
+		s += (char)(i + 1 < n ? link : 0);
+		s.append((const char *)&v, sizeof(v));
+	}
+	return s;
+}
+
+void TestSaveLoad()
+{
+	std::cout << "Testing save and load..." << std::endl;
+	sjtu::priority_queue<int> a;
+	for (int i = 0; i < 10000; ++i) {
+		a.push(i * 7919 % 10007);
+	}
+	for (int i = 0; i < 100; ++i) {
+		a.pop();
+	}
+	sjtu::priority_queue<std::string> b;
+	for (int i = 0; i < 1000; ++i) {
+		b.push(std::to_string(i));
+	}
+	std::stringstream ss;
+	a.save(ss);
+	b.save(ss);
+	sjtu::priority_queue<int> a2;
+	a2.push(1000000);
+	sjtu::priority_queue<std::string> b2;
+	a2.load(ss);
+	b2.load(ss);
+	std::cout << a2.size() << " " << a2.top() << " " << b2.size() << " " << b2.top() << std::endl;
+	bool ok = true;
+	while (!a.empty()) {
+		ok = ok && a.top() == a2.top();
+		a.pop();
+		a2.pop();
+	}
+	a2.push(5);
+	b2.push("zzz");
+	std::cout << ok << " " << a2.empty() << " " << a2.top() << " " << b2.top() << std::endl;
+	std::stringstream short_input(ss.str().substr(0, 100));
+	try {
+		a2.load(short_input);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "too short " << a2.size() << std::endl;
+	}
+}
+
+void TestDeep()
+{
+	std::cout << "Testing deep trees..." << std::endl;
+	for (unsigned char link = 1; link <= 2; ++link) {
+		std::stringstream ss(Chain(1000000, link));
+		sjtu::priority_queue<int> q;
+		q.load(ss);
+		std::cout << q.size() << " " << q.top();
+		bool ok = true;
+		for (int i = 0; i < 1000; ++i) {
+			ok = ok && q.top() == 1000000 - i;
+			q.pop();
+		}
+		q.push(2000000);
+		std::cout << " " << ok << " " << q.size() << " " << q.top() << std::endl;
+	}
+	std::string s = Chain(10, 1);
+	uint64_t count = 9;
+	memcpy(&s[24], &count, sizeof(count));
+	std::stringstream more(s);
+	sjtu::priority_queue<int> q;
+	try {
+		q.load(more);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "too many nodes " << q.size() << std::endl;
+	}
+}
+
+int main()
+{
+	TestSaveLoad();
+	TestDeep();
+	return 0;
+}
@@ -3,7 +3,11 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <utility>
 #include "exceptions.hpp"
+#include "allocator.hpp"
+#include "serialize.hpp"
 
 namespace sjtu {
 
@@ -16,8 +20,9 @@ namespace sjtu {
     /**
     * a container like std::priority_queue which is a heap internal.
     * it should be based on the vector written by yourself.
+    * nodes are allocated by Alloc rebound to the node type, see allocator.hpp.
     */
-    template<typename T, class Compare = std::less<T>>
+    template<typename T, class Compare = std::less<T>, class Alloc = allocator<T>>
     class priority_queue {
     public:
         using value_type = T;
@@ -26,7 +31,22 @@ namespace sjtu {
         using size_type = size_t;
         using difference_type = ptrdiff_t;
 
+        /**
+        * what the queue has done inside, counted only if SJTU_STATS is defined.
+        * merges counts the merges of two heaps done by push, pop and merge,
+        * and the depth of a merge is the number of nodes it walks down the right paths.
+        */
+        struct stats_type {
+            size_t merges = 0;
+            size_t last_merge_depth = 0;
+            size_t max_merge_depth = 0;
+        };
+
     private:
+#ifdef SJTU_STATS
+        stats_type _stats;
+        size_t _depth = 0;
+#endif
         class _Node {
         public:
             _Node() = default;
@@ -38,9 +58,24 @@ namespace sjtu {
             _Node *l = nullptr, *r = nullptr;
         };
 
+        using _NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_Node>;
+        _NodeAlloc _alloc;
+
+        template<class... Args>
+        _Node *_newNode(Args&&... args) {
+            _Node *x = _alloc.allocate(1);
+            new (x) _Node(std::forward<Args>(args)...);
+            return x;
+        }
+        void _deleteNode(_Node *x) {
+            x->~_Node();
+            _alloc.deallocate(x, 1);
+        }
+
         _Node *_merge(_Node *x, _Node *y) {
             if (x == nullptr) return y;
             if (y == nullptr) return x;
+            SJTU_STAT(++_depth);
             if (Compare()(x->data, y->data))
                 sjtu::swap(x, y);
             x->r = _merge(x->r, y);
@@ -52,28 +87,40 @@ namespace sjtu {
                 x->dist = x->r->dist + 1;
             return x;
         }
+        //a merge of two whole heaps, counted in the stats
+        _Node *_mergeHeaps(_Node *x, _Node *y) {
+            SJTU_STAT(_depth = 0);
+            x = _merge(x, y);
+            SJTU_STAT(++_stats.merges);
+            SJTU_STAT(_stats.last_merge_depth = _depth);
+            SJTU_STAT(_stats.max_merge_depth = (_depth > _stats.max_merge_depth ? _depth : _stats.max_merge_depth));
+            return x;
+        }
 
+        //the left child is rotated up until there is none, so a tree of any depth is freed without recursion
         void _dispose(_Node *x) {
-            if (x == nullptr)
-                return;
-            if (x->l != nullptr) {
-                _dispose(x->l);
-                x->l = nullptr;
-            }
-            if (x->r != nullptr) {
-                _dispose(x->r);
-                x->r = nullptr;
+            while (x != nullptr) {
+                if (x->l == nullptr) {
+                    _Node *r = x->r;
+                    _deleteNode(x);
+                    x = r;
+                }
+                else {
+                    _Node *l = x->l;
+                    x->l = l->r;
+                    l->r = x;
+                    x = l;
+                }
             }
-            delete x;
         }
 
         void _copy(_Node *x, _Node *y) {
             if (y->l != nullptr) {
-                x->l = new _Node(*(y->l));
+                x->l = _newNode(*(y->l));
                 _copy(x->l, y->l);
             }
             if (y->r != nullptr) {
-                x->r = new _Node(*(y->r));
+                x->r = _newNode(*(y->r));
                 _copy(x->r, y->r);
             }
         }
@@ -93,9 +140,10 @@ namespace sjtu {
         * TODO constructors
         */
         priority_queue() : root(nullptr), _size(0) {}
-        priority_queue(const priority_queue &other) {
+        explicit priority_queue(const Alloc &alloc) : _alloc(alloc), root(nullptr), _size(0) {}
+        priority_queue(const priority_queue &other) : _alloc(other._alloc) {
             if (other.root != nullptr) {
-                root = new _Node(*(other.root));
+                root = _newNode(*(other.root));
                 _copy(root, other.root);
             }
             _size = other._size;
@@ -111,7 +159,7 @@ namespace sjtu {
                 return *this;
             _clear();
             if (other.root != nullptr) {
-                root = new _Node(*(other.root));
+                root = _newNode(*(other.root));
                 _copy(root, other.root);
             }
             _size = other._size;
@@ -132,8 +180,8 @@ namespace sjtu {
         * push new element to the priority queue.
         */
         void push(const T &e) {
-            _Node *tmp = new _Node(e, 0);
-            root = _merge(root, tmp);
+            _Node *tmp = _newNode(e, 0);
+            root = _mergeHeaps(root, tmp);
             ++_size;
         }
         /**
@@ -145,8 +193,8 @@ namespace sjtu {
             if (root == nullptr)
                 throw container_is_empty();
             _Node *tmp = root;
-            root = _merge(root->l, root->r);
-            delete tmp;
+            root = _mergeHeaps(root->l, root->r);
+            _deleteNode(tmp);
             --_size;
         }
         /**
@@ -162,15 +210,149 @@ namespace sjtu {
         bool empty() const {
             return (root == nullptr);
         }
+        stats_type stats() const {
+#ifdef SJTU_STATS
+            return _stats;
+#else
+            return stats_type();
+#endif
+        }
+        void reset_stats() {
+            SJTU_STAT(_stats = stats_type());
+        }
         /**
         * return a merged priority_queue with at least O(logn) complexity.
+        * the nodes of other are taken over if this allocator can free them,
+        * otherwise they are copied first.
         */
         void merge(priority_queue &other) {
-            root = _merge(root, other.root);
+            if (this == &other)
+                return;
+            if (!(_alloc == other._alloc) && other.root != nullptr) {
+                //copy the nodes of other with this allocator before taking them
+                _Node *r = _newNode(*(other.root));
+                _copy(r, other.root);
+                size_type _n = other._size;
+                other._clear();
+                other.root = r;
+                other._size = _n;
+            }
+            root = _mergeHeaps(root, other.root);
             _size += other._size;
             other.root = nullptr;
             other._size = 0;
         }
+
+        /**
+        * write the elements to os or the file descriptor fd, see serialize.hpp.
+        * the shape of the heap is saved along with them.
+        */
+        void save(std::ostream &os) const {
+            binary_writer out(os);
+            save(out);
+        }
+        void save(int fd) const {
+            binary_writer out(fd);
+            save(out);
+            out.flush();
+        }
+        void save(binary_writer &out) const {
+            _save_header(out, serial_priority_queue, sizeof(T), _serial_bulk<T>::value, _size);
+            _saveNode(out, root);
+        }
+        /**
+        * replace the contents with the elements written by save().
+        * the heap is rebuilt in the shape it was saved in, without comparing any elements.
+        * throw runtime_error if the input holds something else or ends early, leaving the queue empty.
+        */
+        void load(std::istream &is) {
+            binary_reader in(is);
+            load(in);
+        }
+        void load(int fd) {
+            binary_reader in(fd);
+            load(in);
+        }
+        void load(binary_reader &in) {
+            _clear();
+            size_type n = _load_header(in, serial_priority_queue, sizeof(T), _serial_bulk<T>::value);
+            if (n == 0)
+                return;
+            try {
+                _loadNodes(in, n);
+            }
+            catch (...) {
+                _clear();
+                throw;
+            }
+            _size = n;
+        }
+
+    private:
+        //the nodes in preorder, each as a byte telling which children it has and its element
+        void _saveNode(binary_writer &out, const _Node *x) const {
+            if (x == nullptr)
+                return;
+            unsigned char c = (x->l != nullptr ? 1 : 0) | (x->r != nullptr ? 2 : 0);
+            out.write(&c, 1);
+            serializer<T>::save(out, x->data);
+            _saveNode(out, x->l);
+            _saveNode(out, x->r);
+        }
+        _Node *_loadNode(binary_reader &in) {
+            unsigned char c;
+            in.read(&c, 1);
+            _Node *x = _newNode(serializer<T>::load(in));
+            x->dist = c & 3; //the children still to come until the node is done
+            return x;
+        }
+        //rebuild the tree under root with an explicit stack of the nodes not done yet,
+        //as a saved tree may be as deep as it has nodes.
+        //every node is linked in as soon as it is made, so _clear() frees them all on failure
+        void _loadNodes(binary_reader &in, size_type n) {
+            allocator<_Node *> a;
+            size_type cap = 64, top = 0, cnt = 1;
+            _Node **st = a.allocate(cap);
+            try {
+                root = _loadNode(in);
+                st[top++] = root;
+                while (top > 0) {
+                    _Node *x = st[top - 1];
+                    if (x->dist == 0) {
+                        //a file not written by save() may break the leftist shape, which is mended here
+                        if (x->l == nullptr || (x->r != nullptr && x->l->dist < x->r->dist))
+                            sjtu::swap(x->l, x->r);
+                        x->dist = (x->r == nullptr ? 0 : x->r->dist + 1);
+                        --top;
+                        continue;
+                    }
+                    if (cnt == n)
+                        throw runtime_error();
+                    _Node *y = _loadNode(in);
+                    ++cnt;
+                    if (x->dist & 1) {
+                        x->l = y;
+                        x->dist &= ~1;
+                    }
+                    else {
+                        x->r = y;
+                        x->dist &= ~2;
+                    }
+                    if (top == cap) {
+                        st = a.reallocate(st, cap, cap * 2);
+                        cap *= 2;
+                    }
+                    st[top++] = y;
+                }
+                if (cnt != n)
+                    throw runtime_error();
+            }
+            catch (...) {
+                a.deallocate(st, cap);
+                throw;
+            }
+            a.deallocate(st, cap);
+        }
     };
 
 }
@@ -0,0 +1,379 @@
+#ifndef SJTU_COMPRESSED_VECTOR_HPP
+#define SJTU_COMPRESSED_VECTOR_HPP
+
+#include "simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace sjtu {
+
+namespace _simd {
+
+/**
+ * unpacking one block of 128 values of width bits into out.
+ * the block is 4 interleaved lanes: value i belongs to lane i % 4, and the m-th word
+ * of a lane is words[4 * m + lane], so one vector of 4 words yields 4 consecutive values.
+ */
+struct _bp_scalar {
+    static void unpack(const uint64_t *words, unsigned width, uint64_t *out) {
+        if (width == 0) {
+            memset(out, 0, sizeof(uint64_t) * 128);
+            return;
+        }
+        const uint64_t mask = width == 64 ? ~(uint64_t)0 : ((uint64_t)1 << width) - 1;
+        for (size_t j = 0; j < 32; ++j) {
+            size_t bit = j * width, m = bit >> 6, s = bit & 63;
+            for (size_t k = 0; k < 4; ++k) {
+                uint64_t x = words[4 * m + k] >> s | (words[4 * m + 4 + k] << 1) << (63 - s);
+                out[4 * j + k] = x & mask;
+            }
+        }
+    }
+};
+
+#ifdef SJTU_SIMD_X86
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+//the same on vectors of W bytes, every lane is shifted by the same amount
+template <size_t W>
+struct _bp_kernel {
+    typedef uint64_t _vec __attribute__((vector_size(W)));
+    static constexpr size_t L = W / 8;
+
+    static inline __attribute__((always_inline)) void unpack(const uint64_t *words, unsigned width, uint64_t *out) {
+        if (width == 0) {
+            memset(out, 0, sizeof(uint64_t) * 128);
+            return;
+        }
+        const _vec mask = _vec{} + (width == 64 ? ~(uint64_t)0 : ((uint64_t)1 << width) - 1);
+        for (size_t j = 0; j < 32; ++j) {
+            size_t bit = j * width, m = bit >> 6, s = bit & 63;
+            for (size_t k = 0; k < 4; k += L) {
+                _vec x, y;
+                memcpy(&x, words + 4 * m + k, W);
+                memcpy(&y, words + 4 * m + 4 + k, W);
+                //y << (64 - s) without the shift by 64 when s is 0
+                x = (x >> s | (y << 1) << (63 - s)) & mask;
+                memcpy(out + 4 * j + k, &x, W);
+            }
+        }
+    }
+};
+
+__attribute__((target("avx2"))) inline void _bp_unpack_avx2(const uint64_t *words, unsigned width, uint64_t *out) {
+    _bp_kernel<32>::unpack(words, width, out);
+}
+__attribute__((target("sse4.2"))) inline void _bp_unpack_sse4(const uint64_t *words, unsigned width, uint64_t *out) {
+    _bp_kernel<16>::unpack(words, width, out);
+}
+inline void _bp_unpack(const uint64_t *words, unsigned width, uint64_t *out) {
+    switch (level()) {
+    case 2: return _bp_unpack_avx2(words, width, out);
+    case 1: return _bp_unpack_sse4(words, width, out);
+    default: return _bp_scalar::unpack(words, width, out);
+    }
+}
+
+#pragma GCC diagnostic pop
+
+#else
+
+inline void _bp_unpack(const uint64_t *words, unsigned width, uint64_t *out) {
+    _bp_scalar::unpack(words, width, out);
+}
+
+#endif
+
+}
+
+/**
+ * a read-only vector of integers, compressed when it is built.
+ * the values are cut into blocks of 128, and each block is bit-packed at the smallest width
+ * that holds all of its values relative to the block minimum (frame of reference).
+ * if the input is sorted, each block keeps its first value and the bit-packed differences
+ * between neighbours instead, which is much narrower for posting lists and timestamps.
+ * a block costs 16 bytes of header besides its packed words.
+ *
+ * at() and [] are O(1): one or two words are read, and for sorted input
+ * at most 127 differences are added up.
+ * decode_block() unpacks a whole block with SIMD kernels (see simd.hpp),
+ * scans should go through it or decode() rather than element by element.
+ */
+template<typename Int>
+class compressed_vector {
+    static_assert(std::is_integral<Int>::value && !std::is_same<Int, bool>::value,
+        "compressed_vector holds integers");
+
+public:
+    using value_type        = Int;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    static constexpr size_t block_size = 128;
+
+private:
+    using _U = typename std::make_unsigned<Int>::type;
+
+    struct _Block {
+        uint64_t base;  //the minimum, or the first value if delta encoded
+        uint64_t info;  //offset of the words << 8 | width
+    };
+
+    vector<uint64_t> _words;
+    vector<_Block> _blocks;
+    size_type _size = 0;
+    bool _delta = false;
+
+public:
+    compressed_vector() = default;
+    compressed_vector(const Int *p, size_type n) {
+        _build(p, n);
+    }
+    template<class Growth, class Alloc>
+    explicit compressed_vector(const vector<Int, Growth, Alloc> &v) {
+        _build(v.data(), v.size());
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+    //whether the blocks hold differences, which they do if the input was sorted
+    bool delta() const {
+        return _delta;
+    }
+    size_type block_count() const {
+        return _blocks.size();
+    }
+    //the bytes used by the packed values and the block headers
+    size_type bytes() const {
+        return _words.size() * sizeof(uint64_t) + _blocks.size() * sizeof(_Block);
+    }
+
+    Int at(const size_type &pos) const {
+        if (pos >= _size)
+            throw index_out_of_bound();
+        return _get(pos);
+    }
+    Int operator [](const size_type &pos) const {
+        if (checked_access && pos >= _size)
+            throw index_out_of_bound();
+        return _get(pos);
+    }
+    Int front() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _get(0);
+    }
+    Int back() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _get(_size - 1);
+    }
+
+    //write the values of block b to out, return how many there are (128 but for the last block)
+    size_type decode_block(size_type b, Int *out) const {
+        if (b >= _blocks.size())
+            throw index_out_of_bound();
+        const _Block &blk = _blocks[b];
+        uint64_t buf[block_size];
+        _simd::_bp_unpack(_words.data() + (blk.info >> 8), blk.info & 255, buf);
+        size_type n = _size - b * block_size < block_size ? _size - b * block_size : block_size;
+        _U v = (_U)blk.base;
+        if (_delta)
+            for (size_type i = 0; i < n; ++i) {
+                v = (_U)(v + (_U)buf[i]);
+                out[i] = (Int)v;
+            }
+        else
+            for (size_type i = 0; i < n; ++i)
+                out[i] = (Int)(_U)(v + (_U)buf[i]);
+        return n;
+    }
+    //write all the values to out
+    void decode(Int *out) const {
+        for (size_type b = 0; b < _blocks.size(); ++b)
+            out += decode_block(b, out);
+    }
+    vector<Int> to_vector() const {
+        vector<Int> v;
+        v.resize(_size);
+        decode(v.data());
+        return v;
+    }
+
+    /**
+     * a random access iterator giving the values by value
+     */
+    class const_iterator {
+        friend class compressed_vector;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Int;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Int *;
+        using reference         = Int;
+    private:
+        const compressed_vector *_container = nullptr;
+        size_t _pos = 0;
+        const_iterator(const compressed_vector *c, size_t pos) : _container(c), _pos(pos) {}
+    public:
+        const_iterator() = default;
+        Int operator *() const {
+            return (*_container)[_pos];
+        }
+        Int operator [](const difference_type &n) const {
+            return (*_container)[_pos + n];
+        }
+        const_iterator operator +(const difference_type &n) const {
+            return const_iterator(_container, _pos + n);
+        }
+        const_iterator operator -(const difference_type &n) const {
+            return const_iterator(_container, _pos - n);
+        }
+        difference_type operator -(const const_iterator &rhs) const {
+            if (checked_access && _container != rhs._container)
+                throw invalid_iterator();
+            return (difference_type)_pos - (difference_type)rhs._pos;
+        }
+        const_iterator &operator +=(const difference_type &n) {
+            _pos += n;
+            return *this;
+        }
+        const_iterator &operator -=(const difference_type &n) {
+            _pos -= n;
+            return *this;
+        }
+        const_iterator &operator ++() {
+            ++_pos;
+            return *this;
+        }
+        const_iterator operator ++(int) {
+            const_iterator t = *this;
+            ++_pos;
+            return t;
+        }
+        const_iterator &operator --() {
+            --_pos;
+            return *this;
+        }
+        const_iterator operator --(int) {
+            const_iterator t = *this;
+            --_pos;
+            return t;
+        }
+        bool operator ==(const const_iterator &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        bool operator !=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, _size);
+    }
+
+private:
+    static unsigned _bits(uint64_t x) {
+        unsigned r = 0;
+        while (x != 0) {
+            ++r;
+            x >>= 1;
+        }
+        return r;
+    }
+    //the words of a block of width bits
+    static size_type _block_words(unsigned width) {
+        return 4 * ((width + 1) / 2);
+    }
+
+    void _build(const Int *p, size_type n) {
+        _size = n;
+        _delta = true;
+        for (size_type i = 1; i < n && _delta; ++i)
+            _delta = !(p[i] < p[i - 1]);
+        size_type nb = (n + block_size - 1) / block_size;
+        _blocks.reserve(nb);
+        uint64_t vals[block_size];
+        for (size_type b = 0; b < nb; ++b) {
+            const Int *q = p + b * block_size;
+            size_type len = n - b * block_size < block_size ? n - b * block_size : block_size;
+            //the values relative to base, as unsigned in the width of Int
+            Int lo = q[0];
+            if (!_delta)
+                for (size_type i = 1; i < len; ++i)
+                    if (q[i] < lo)
+                        lo = q[i];
+            _U base = (_U)lo;
+            uint64_t hi = 0;
+            for (size_type i = 0; i < block_size; ++i) {
+                if (i >= len)
+                    vals[i] = 0;
+                else if (_delta)
+                    vals[i] = i == 0 ? 0 : (uint64_t)(_U)((_U)q[i] - (_U)q[i - 1]);
+                else
+                    vals[i] = (uint64_t)(_U)((_U)q[i] - base);
+                hi |= vals[i];
+            }
+            unsigned width = _bits(hi);
+            _blocks.push_back(_Block{(uint64_t)base, (uint64_t)_words.size() << 8 | width});
+            _pack(vals, width);
+        }
+        //the unpacking kernels read one row of words past the end of a block
+        _words.resize(_words.size() + 4);
+    }
+    void _pack(const uint64_t *vals, unsigned width) {
+        if (width == 0)
+            return;
+        size_type off = _words.size();
+        _words.resize(off + _block_words(width));
+        uint64_t *w = _words.data() + off;
+        for (size_type j = 0; j < 32; ++j) {
+            size_t bit = j * width, m = bit >> 6, s = bit & 63;
+            for (size_t k = 0; k < 4; ++k) {
+                uint64_t x = vals[4 * j + k];
+                w[4 * m + k] |= x << s;
+                if (s + width > 64)
+                    w[4 * m + 4 + k] |= x >> (64 - s);
+            }
+        }
+    }
+
+    //the r-th packed value of block b
+    uint64_t _packed(const _Block &blk, size_type r) const {
+        unsigned width = blk.info & 255;
+        if (width == 0)
+            return 0;
+        const uint64_t *w = _words.data() + (blk.info >> 8);
+        size_t bit = (r >> 2) * width, m = bit >> 6, s = bit & 63, k = r & 3;
+        uint64_t x = w[4 * m + k] >> s;
+        if (s + width > 64)
+            x |= w[4 * m + 4 + k] << (64 - s);
+        return width == 64 ? x : x & (((uint64_t)1 << width) - 1);
+    }
+    Int _get(size_type pos) const {
+        const _Block &blk = _blocks[pos / block_size];
+        size_type r = pos % block_size;
+        _U v = (_U)blk.base;
+        if (!_delta)
+            return (Int)(_U)(v + (_U)_packed(blk, r));
+        for (size_type i = 1; i <= r; ++i)
+            v = (_U)(v + (_U)_packed(blk, i));
+        return (Int)v;
+    }
+};
+
+}
+
+#endif
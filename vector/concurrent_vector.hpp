@@ -0,0 +1,306 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * an append-only vector for many threads.
+ * the elements are kept in segments of 32, 64, 128, ... elements which are never moved,
+ * so pointers and references to elements stay valid until the vector is destroyed.
+ *
+ * push_back and emplace_back may be called from any number of threads at once:
+ * a slot is reserved by one atomic increment and a missing segment is installed by one CAS.
+ * size() counts the leading elements whose construction has completed,
+ * and any of them may be read while others are being appended.
+ * the pushing thread that completes the element right after size() moves size() forward,
+ * so no thread ever waits for another.
+ *
+ * if the constructor of an element throws, its slot is left as a hole that size() counts
+ * but that holds no element, the exception reaches the pushing thread.
+ * valid() tells the holes, at() and a checked operator [] throw runtime_error on them,
+ * and the iterators skip them.
+ * if the segment of a slot cannot be allocated, size() stops in front of that slot until clear().
+ *
+ * clear(), reserve() and the destructor must not run alongside other members.
+ * the segments come from malloc.
+ */
+template<typename T>
+class concurrent_vector {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc cannot align the elements");
+
+public:
+    using value_type        = T;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+private:
+    static constexpr size_t FIRST_BITS = 5; //the first segment has 32 elements
+    static constexpr size_t SEGMENTS = sizeof(size_t) * 8 - FIRST_BITS;
+
+    using _Flag = std::atomic<unsigned char>;
+    //the states of a slot, size() moves past both DONE and HOLE
+    static constexpr unsigned char EMPTY = 0, DONE = 1, HOLE = 2;
+    //a segment is its elements followed by one ready flag per element
+    std::atomic<T *> _segments[SEGMENTS];
+    std::atomic<size_t> _reserved;
+    std::atomic<size_t> _published;
+
+public:
+    concurrent_vector() : _reserved(0), _published(0) {
+        for (size_t k = 0; k < SEGMENTS; ++k)
+            _segments[k].store(nullptr, std::memory_order_relaxed);
+    }
+    concurrent_vector(const concurrent_vector &) = delete;
+    concurrent_vector &operator =(const concurrent_vector &) = delete;
+    ~concurrent_vector() {
+        clear();
+    }
+
+    //append value and return its index
+    template<class... Args>
+    size_type emplace_back(Args&&... args) {
+        size_t i = _reserved.fetch_add(1, std::memory_order_relaxed);
+        size_t k = _segment(i), j = i - _segment_begin(k);
+        T *seg = _get_segment(k);
+        try {
+            new (seg + j) T(std::forward<Args>(args)...);
+        } catch (...) {
+            _flags(seg, k)[j].store(HOLE);
+            _publish();
+            throw;
+        }
+        _flags(seg, k)[j].store(DONE); //seq_cst, see _publish
+        _publish();
+        return i;
+    }
+    size_type push_back(const T &value) {
+        return emplace_back(value);
+    }
+    size_type push_back(T &&value) {
+        return emplace_back(std::move(value));
+    }
+
+    //the number of leading elements that may be read
+    size_type size() const {
+        return _published.load(std::memory_order_acquire);
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+    //the number of elements the allocated segments hold
+    size_type capacity() const {
+        size_t k = 0;
+        while (k < SEGMENTS && _segments[k].load(std::memory_order_acquire) != nullptr)
+            ++k;
+        return _segment_begin(k);
+    }
+
+    //whether pos is below size() and holds an element rather than a hole
+    bool valid(const size_type &pos) const {
+        return pos < size() && _done(pos);
+    }
+    T &at(const size_type &pos) {
+        _check(pos);
+        return _at(pos);
+    }
+    const T &at(const size_type &pos) const {
+        _check(pos);
+        return _at(pos);
+    }
+    T &operator [](const size_type &pos) {
+        if (checked_access)
+            _check(pos);
+        return _at(pos);
+    }
+    const T &operator [](const size_type &pos) const {
+        if (checked_access)
+            _check(pos);
+        return _at(pos);
+    }
+
+    //allocate the segments for n elements in advance
+    void reserve(size_type n) {
+        for (size_t k = 0; k < SEGMENTS && _segment_begin(k) < n; ++k)
+            _get_segment(k);
+    }
+    void clear() {
+        size_t n = _reserved.load(std::memory_order_acquire);
+        for (size_t k = 0; k < SEGMENTS; ++k) {
+            T *seg = _segments[k].load(std::memory_order_acquire);
+            if (seg == nullptr)
+                continue;
+            size_t b = _segment_begin(k), len = _segment_size(k);
+            for (size_t j = 0; j < len && b + j < n; ++j)
+                if (_flags(seg, k)[j].load(std::memory_order_acquire) == DONE)
+                    seg[j].~T();
+            _free_segment(seg, k);
+            _segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+        _reserved.store(0, std::memory_order_relaxed);
+        _published.store(0, std::memory_order_release);
+    }
+
+    /**
+     * an iterator over the elements counted by size() when it was made, holes are skipped
+     */
+    template<class V, class C>
+    class _iterator {
+        friend class concurrent_vector;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = V *;
+        using reference         = V &;
+    private:
+        C *_container = nullptr;
+        size_t _pos = 0;
+        size_t _end = 0;
+        _iterator(C *c, size_t pos, size_t end) : _container(c), _pos(pos), _end(end) {
+            _skip();
+        }
+        void _skip() {
+            while (_pos < _end && !_container->_done(_pos))
+                ++_pos;
+        }
+    public:
+        _iterator() = default;
+        template<class V2, class C2>
+        _iterator(const _iterator<V2, C2> &other) : _container(other._container), _pos(other._pos), _end(other._end) {}
+        V &operator *() const {
+            return (*_container)[_pos];
+        }
+        V *operator ->() const {
+            return &**this;
+        }
+        _iterator &operator ++() {
+            ++_pos;
+            _skip();
+            return *this;
+        }
+        _iterator operator ++(int) {
+            _iterator t = *this;
+            ++*this;
+            return t;
+        }
+        bool operator ==(const _iterator &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        bool operator !=(const _iterator &rhs) const {
+            return !(*this == rhs);
+        }
+        template<class V2, class C2>
+        friend class _iterator;
+    };
+    using iterator          = _iterator<T, concurrent_vector>;
+    using const_iterator    = _iterator<const T, const concurrent_vector>;
+
+    iterator begin() {
+        return iterator(this, 0, size());
+    }
+    iterator end() {
+        size_t n = size();
+        return iterator(this, n, n);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0, size());
+    }
+    const_iterator cend() const {
+        size_t n = size();
+        return const_iterator(this, n, n);
+    }
+
+private:
+    //element i lives in the segment k such that 32 * (2^k - 1) <= i < 32 * (2^(k+1) - 1)
+    static size_t _log2(size_t x) {
+#ifdef __GNUC__
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll((unsigned long long)x);
+#else
+        size_t r = 0;
+        while (x >>= 1)
+            ++r;
+        return r;
+#endif
+    }
+    static size_t _segment(size_t i) {
+        return _log2((i >> FIRST_BITS) + 1);
+    }
+    static size_t _segment_begin(size_t k) {
+        return (((size_t)1 << k) - 1) << FIRST_BITS;
+    }
+    static size_t _segment_size(size_t k) {
+        return (size_t)1 << (k + FIRST_BITS);
+    }
+    static _Flag *_flags(T *seg, size_t k) {
+        return (_Flag *)(seg + _segment_size(k));
+    }
+
+    T &_at(size_t i) const {
+        size_t k = _segment(i);
+        return _segments[k].load(std::memory_order_acquire)[i - _segment_begin(k)];
+    }
+    //whether the slot i below size() holds an element
+    bool _done(size_t i) const {
+        size_t k = _segment(i);
+        T *seg = _segments[k].load(std::memory_order_acquire);
+        return _flags(seg, k)[i - _segment_begin(k)].load(std::memory_order_acquire) == DONE;
+    }
+    void _check(size_t pos) const {
+        if (pos >= size())
+            throw index_out_of_bound();
+        if (!_done(pos))
+            throw runtime_error();
+    }
+
+    //the segment k, installed by whichever thread gets there first
+    T *_get_segment(size_t k) {
+        T *seg = _segments[k].load(std::memory_order_acquire);
+        if (seg != nullptr)
+            return seg;
+        size_t len = _segment_size(k);
+        T *fresh = (T *)malloc(sizeof(T) * len + sizeof(_Flag) * len);
+        if (fresh == nullptr)
+            throw std::bad_alloc();
+        for (size_t j = 0; j < len; ++j)
+            new (_flags(fresh, k) + j) _Flag(EMPTY);
+        if (_segments[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            return fresh;
+        _free_segment(fresh, k);
+        return seg;
+    }
+    static void _free_segment(T *seg, size_t k) {
+        size_t len = _segment_size(k);
+        for (size_t j = 0; j < len; ++j)
+            _flags(seg, k)[j].~_Flag();
+        free((void *)seg);
+    }
+
+    //move size() over the elements completed in a row
+    void _publish() {
+        size_t p = _published.load(std::memory_order_acquire);
+        while (p < _reserved.load(std::memory_order_acquire)) {
+            size_t k = _segment(p);
+            T *seg = _segments[k].load(std::memory_order_acquire);
+            //the flags are seq_cst: of two threads completing neighbours at once,
+            //at least one sees the other's flag, so no completed element is left behind
+            if (seg == nullptr || _flags(seg, k)[p - _segment_begin(k)].load() == EMPTY)
+                return;
+            //on failure p is reloaded as another thread has made progress
+            if (_published.compare_exchange_weak(p, p + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+                ++p;
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef SJTU_COW_VECTOR_HPP
+#define SJTU_COW_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a vector sharing its elements between copies until one of them is modified.
+ * copying or assigning only takes another reference to the shared buffer,
+ * the first modification through a shared copy copies the elements for it alone.
+ * the reference count is atomic, so copies may live in different threads.
+ *
+ * the const members only read; every non-const member, including the non-const
+ * operator [], begin() and data(), makes the buffer unshared first.
+ * references, pointers and iterators got from a non-const member are invalidated
+ * by copying the vector, as the next modification may move the elements away from them.
+ */
+template<typename T, class Growth = growth_double, class Alloc = allocator<T>>
+class cow_vector {
+public:
+    //a packed vector<bool> could not hand out bool references
+    using _vector           = vector<T, Growth, _unpacked_t<Alloc>>;
+    using value_type        = T;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using iterator          = typename _vector::iterator;
+    using const_iterator    = typename _vector::const_iterator;
+
+private:
+    template<class InputIt>
+    using _if_iterator = typename std::enable_if<!std::is_integral<InputIt>::value>::type;
+
+    struct _Shared {
+        std::atomic<size_t> refs;
+        _vector data;
+        template<class... Args>
+        _Shared(Args&&... args) : refs(1), data(std::forward<Args>(args)...) {}
+    };
+    _Shared *_shared;
+
+public:
+    cow_vector() : _shared(new _Shared()) {}
+    explicit cow_vector(const Alloc &alloc) : _shared(new _Shared(alloc)) {}
+    cow_vector(size_type n, const T &value, const Alloc &alloc = Alloc()) : _shared(new _Shared(n, value, alloc)) {}
+    template<class InputIt, class = _if_iterator<InputIt>>
+    cow_vector(InputIt first, InputIt last, const Alloc &alloc = Alloc()) :
+        _shared(new _Shared(first, last, alloc)) {}
+    //take the elements of a vector without copying them
+    explicit cow_vector(_vector &&other) : _shared(new _Shared(std::move(other))) {}
+    cow_vector(const cow_vector &other) : _shared(other._shared) {
+        _shared->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    cow_vector(cow_vector &&other) : _shared(other._shared) {
+        other._shared = nullptr;
+    }
+    ~cow_vector() {
+        _release();
+    }
+    cow_vector &operator =(const cow_vector &other) {
+        if (_shared == other._shared)
+            return *this;
+        other._shared->refs.fetch_add(1, std::memory_order_relaxed);
+        _release();
+        _shared = other._shared;
+        return *this;
+    }
+    cow_vector &operator =(cow_vector &&other) {
+        if (this == &other)
+            return *this;
+        _release();
+        _shared = other._shared;
+        other._shared = nullptr;
+        return *this;
+    }
+
+    //the number of copies sharing the elements
+    size_type use_count() const {
+        return _shared == nullptr ? 0 : _shared->refs.load(std::memory_order_acquire);
+    }
+    bool unique() const {
+        return use_count() == 1;
+    }
+    //the shared elements, read only
+    const _vector &get() const {
+        return _read();
+    }
+
+    const T &at(const size_type &pos) const {
+        return _read().at(pos);
+    }
+    T &at(const size_type &pos) {
+        return _write().at(pos);
+    }
+    const T &operator [](const size_type &pos) const {
+        return _read()[pos];
+    }
+    T &operator [](const size_type &pos) {
+        return _write()[pos];
+    }
+    const T &front() const {
+        return _read().front();
+    }
+    const T &back() const {
+        return _read().back();
+    }
+    const T *data() const {
+        return _read().data();
+    }
+    T *data() {
+        return _write().data();
+    }
+    iterator begin() {
+        return _write().begin();
+    }
+    iterator end() {
+        return _write().end();
+    }
+    const_iterator cbegin() const {
+        return _read().cbegin();
+    }
+    const_iterator cend() const {
+        return _read().cend();
+    }
+    bool empty() const {
+        return _read().empty();
+    }
+    size_type size() const {
+        return _read().size();
+    }
+    size_type capacity() const {
+        return _read().capacity();
+    }
+
+    //a shared buffer is let go of instead of being copied and then emptied
+    void clear() {
+        if (unique())
+            _shared->data.clear();
+        else {
+            _release();
+            _shared = new _Shared();
+        }
+    }
+    void reserve(size_type n) {
+        _write().reserve(n);
+    }
+    void shrink_to_fit() {
+        _write().shrink_to_fit();
+    }
+    void resize(size_type n) {
+        _write().resize(n);
+    }
+    void resize(size_type n, const T &value) {
+        _write().resize(n, value);
+    }
+    void assign(size_type n, const T &value) {
+        _fresh().assign(n, value);
+    }
+    template<class InputIt, class = _if_iterator<InputIt>>
+    void assign(InputIt first, InputIt last) {
+        _fresh().assign(first, last);
+    }
+
+    //pos is taken by its index, so it may come from before the buffer was unshared
+    template<class... Args>
+    iterator emplace(iterator pos, Args&&... args) {
+        size_type ind = _index(pos);
+        _vector &v = _write();
+        return v.emplace(v.begin() + ind, std::forward<Args>(args)...);
+    }
+    iterator insert(iterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+    iterator insert(iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+    iterator insert(const size_type &ind, const T &value) {
+        return _write().insert(ind, value);
+    }
+    iterator insert(const size_type &ind, T &&value) {
+        return _write().insert(ind, std::move(value));
+    }
+    iterator insert(iterator pos, size_type n, const T &value) {
+        size_type ind = _index(pos);
+        _vector &v = _write();
+        return v.insert(v.begin() + ind, n, value);
+    }
+    template<class InputIt, class = _if_iterator<InputIt>>
+    iterator insert(iterator pos, InputIt first, InputIt last) {
+        size_type ind = _index(pos);
+        _vector &v = _write();
+        return v.insert(v.begin() + ind, first, last);
+    }
+    iterator erase(iterator pos) {
+        size_type ind = _index(pos);
+        _vector &v = _write();
+        return v.erase(v.begin() + ind);
+    }
+    iterator erase(iterator first, iterator last) {
+        size_type ind = _index(first), n = last - first;
+        _vector &v = _write();
+        return v.erase(v.begin() + ind, v.begin() + (ind + n));
+    }
+    iterator erase(const size_t &ind) {
+        return _write().erase(ind);
+    }
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        _write().emplace_back(std::forward<Args>(args)...);
+    }
+    void push_back(const T &value) {
+        _write().push_back(value);
+    }
+    void push_back(T &&value) {
+        _write().push_back(std::move(value));
+    }
+    void pop_back() {
+        _write().pop_back();
+    }
+
+private:
+    //a moved-from cow_vector reads as empty and gets a new buffer when written
+    const _vector &_read() const {
+        static const _vector _empty;
+        return _shared == nullptr ? _empty : _shared->data;
+    }
+    //the elements, copied first if they are shared
+    _vector &_write() {
+        if (_shared == nullptr)
+            _shared = new _Shared();
+        else if (!unique()) {
+            _Shared *s = new _Shared(_shared->data);
+            _release();
+            _shared = s;
+        }
+        return _shared->data;
+    }
+    //a buffer for new contents, the old ones are not copied
+    _vector &_fresh() {
+        if (!unique()) {
+            _release();
+            _shared = new _Shared();
+        }
+        return _shared->data;
+    }
+    size_type _index(const iterator &pos) const {
+        return pos - const_cast<_vector &>(_read()).begin();
+    }
+    void _release() {
+        if (_shared != nullptr && _shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete _shared;
+        _shared = nullptr;
+    }
+};
+
+}
+
+#endif
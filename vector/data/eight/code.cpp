@@ -0,0 +1,70 @@
+#include "simd.hpp"
+
+#include <iostream>
+#include <string>
+
+template <class T>
+void TestType(const std::string &name)
+{
+	std::cout << "Testing " << name << "..." << std::endl;
+	for (int n : {0, 1, 5, 31, 32, 33, 1000, 100003}) {
+		sjtu::vector<T> v;
+		unsigned int seed = 12345;
+		for (int i = 0; i < n; ++i) {
+			seed = seed * 1103515245 + 12345;
+			v.push_back((T)((seed >> 16) % 100));
+		}
+		std::cout << n << ":";
+		std::cout << " find " << sjtu::find(v, (T)42) - v.begin();
+		std::cout << " count " << sjtu::count(v, (T)42);
+		if (n > 0) {
+			std::cout << " min " << +*sjtu::min_element(v) << "@" << sjtu::min_element(v) - v.begin();
+			std::cout << " max " << +*sjtu::max_element(v) << "@" << sjtu::max_element(v) - v.begin();
+		}
+		std::cout << " sum " << sjtu::accumulate(v, 0LL);
+		sjtu::vector<T> w(v);
+		std::cout << " equal " << sjtu::equal(v, w);
+		if (n > 0) {
+			w[n / 2] = w[n / 2] + 1;
+			std::cout << " " << sjtu::equal(v, w);
+		}
+		std::cout << std::endl;
+	}
+}
+
+void TestEdge()
+{
+	std::cout << "Testing edges..." << std::endl;
+	sjtu::vector<unsigned char> c(100000, 1);
+	std::cout << sjtu::count(c, (unsigned char)1) << " " << +sjtu::accumulate(c, (unsigned char)0) << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i % 10);
+	}
+	std::cout << sjtu::accumulate(v, 0) << " " << sjtu::find(v, 10) - v.begin() << std::endl;
+	const sjtu::vector<int> &cv = v;
+	std::cout << *sjtu::min_element(cv) << " " << *sjtu::max_element(cv) << " "
+	          << sjtu::max_element(cv) - cv.cbegin() << std::endl;
+	sjtu::vector<double> d;
+	d.push_back(0.0);
+	for (int i = 0; i < 40; ++i) {
+		d.push_back(-0.0);
+	}
+	d.push_back(1.5);
+	std::cout << sjtu::min_element(d) - d.begin() << " " << sjtu::max_element(d) - d.begin() << std::endl;
+	sjtu::vector<double> e(d);
+	std::cout << sjtu::equal(d, e) << std::endl;
+}
+
+int main()
+{
+	TestType<char>("char");
+	TestType<short>("short");
+	TestType<int>("int");
+	TestType<unsigned int>("unsigned int");
+	TestType<long long>("long long");
+	TestType<float>("float");
+	TestType<double>("double");
+	TestEdge();
+	return 0;
+}
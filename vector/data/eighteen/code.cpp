@@ -0,0 +1,106 @@
+#include "static_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+constexpr sjtu::static_vector<int, 8> Squares()
+{
+	sjtu::static_vector<int, 8> v;
+	for (int i = 0; i < 6; ++i) {
+		v.push_back(i * i);
+	}
+	v.erase(v.begin() + 1);
+	v.insert(0, 100);
+	v.pop_back();
+	return v;
+}
+
+constexpr int Sum(const sjtu::static_vector<int, 8> &v)
+{
+	int s = 0;
+	for (auto it = v.cbegin(); it != v.cend(); ++it) {
+		s += *it;
+	}
+	return s;
+}
+
+static_assert(Squares().size() == 5, "size");
+static_assert(Squares()[0] == 100 && Squares()[1] == 0 && Squares()[2] == 4, "elements");
+static_assert(Sum(Squares()) == 100 + 0 + 4 + 9 + 16, "sum");
+static_assert(sjtu::static_vector<int, 3>{1, 2, 3}.full(), "full");
+static_assert(sizeof(sjtu::static_vector<int, 8>) == 8 * sizeof(int) + sizeof(size_t), "inline");
+
+void TestTrivial()
+{
+	std::cout << "Testing trivial..." << std::endl;
+	sjtu::static_vector<int, 16> v(4, 7);
+	for (int i = 0; i < 12; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.size() << " " << v.capacity() << " " << v.full() << std::endl;
+	try {
+		v.push_back(0);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "full" << std::endl;
+	}
+	try {
+		v.at(16);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	v.erase(v.begin() + 2, v.begin() + 6);
+	v.resize(14, -1);
+	for (auto it = v.begin(); it != v.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl;
+	sjtu::static_vector<int, 16> w = v;
+	w[0] = 42;
+	std::cout << v[0] << " " << w[0] << " " << w.back() << std::endl;
+	try {
+		v.erase(w.begin());
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid iterator" << std::endl;
+	}
+}
+
+void TestStrings()
+{
+	std::cout << "Testing strings..." << std::endl;
+	sjtu::static_vector<std::string, 5> v;
+	v.emplace_back(3, 'a');
+	v.push_back("bb");
+	v.insert(v.begin(), "first");
+	v.insert(1, std::string("second"));
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::static_vector<std::string, 5> w(v);
+	v.erase(1);
+	v.push_back("x");
+	v.push_back("y");
+	try {
+		v.insert(0, "z");
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "full" << std::endl;
+	}
+	w = std::move(v);
+	for (auto it = w.cbegin(); it != w.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << w.size() << std::endl;
+	w.clear();
+	try {
+		w.front();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty" << std::endl;
+	}
+}
+
+int main()
+{
+	TestTrivial();
+	TestStrings();
+	return 0;
+}
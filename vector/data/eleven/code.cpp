@@ -0,0 +1,121 @@
+#include "cow_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+template <class Vector>
+void Print(const Vector &v)
+{
+	std::cout << v.use_count() << " " << v.size() << ":";
+	for (typename Vector::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << std::endl;
+}
+
+void TestShare()
+{
+	std::cout << "Testing sharing..." << std::endl;
+	sjtu::cow_vector<std::string> a;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(std::to_string(i));
+	}
+	sjtu::cow_vector<std::string> b = a, c;
+	c = b;
+	Print(a);
+	std::cout << (a.get().data() == c.get().data()) << std::endl;
+	const sjtu::cow_vector<std::string> &cb = b;
+	std::cout << cb[2] << " " << cb.at(3) << " " << cb.front() << " " << cb.back() << std::endl;
+	b.push_back("b");
+	Print(a);
+	Print(b);
+	c[0] = "c";
+	Print(a);
+	Print(c);
+	a[1] = "a";
+	Print(a);
+	std::cout << (a.get().data() == c.get().data()) << std::endl;
+}
+
+void TestIterators()
+{
+	std::cout << "Testing iterators..." << std::endl;
+	sjtu::cow_vector<int> a(5, 1);
+	sjtu::cow_vector<int>::iterator it = a.begin() + 2;
+	sjtu::cow_vector<int> b = a;
+	a.insert(it, 7);
+	a.erase(a.begin());
+	Print(a);
+	Print(b);
+	b.erase(b.begin() + 1, b.end());
+	b.insert(b.end(), 3, 9);
+	Print(b);
+	sjtu::cow_vector<int> c = b;
+	c.clear();
+	Print(b);
+	Print(c);
+	c.assign(b.cbegin(), b.cend());
+	Print(c);
+	sjtu::cow_vector<int> d(std::move(c));
+	Print(c);
+	Print(d);
+	c = d;
+	c.pop_back();
+	Print(c);
+	Print(d);
+}
+
+void TestThreads()
+{
+	std::cout << "Testing threads..." << std::endl;
+	sjtu::vector<long long> base;
+	for (int i = 0; i < 1000; ++i) {
+		base.push_back(i);
+	}
+	sjtu::cow_vector<long long> a(std::move(base));
+	long long sums[4];
+	std::thread ts[4];
+	for (int t = 0; t < 4; ++t) {
+		ts[t] = std::thread([a, t, &sums]() mutable {
+			for (int r = 0; r < 100; ++r) {
+				sjtu::cow_vector<long long> b = a;
+				if (r % 10 == t) {
+					b[0] += 1;
+				}
+			}
+			a.push_back(t);
+			long long s = 0;
+			for (size_t i = 0; i < a.size(); ++i) {
+				s += a[i];
+			}
+			sums[t] = s;
+		});
+	}
+	for (int t = 0; t < 4; ++t) {
+		ts[t].join();
+		std::cout << sums[t] << std::endl;
+	}
+	Print(sjtu::cow_vector<long long>(a.cbegin(), a.cbegin() + 3));
+	std::cout << a.use_count() << std::endl;
+}
+
+void TestBool()
+{
+	std::cout << "Testing bool..." << std::endl;
+	sjtu::cow_vector<bool> a(5, false);
+	sjtu::cow_vector<bool> b = a;
+	bool &r = b[3];
+	r = true;
+	b[1] = true;
+	std::cout << a[1] << a[3] << " " << b[1] << b[3] << " " << a.use_count() << b.use_count() << std::endl;
+}
+
+int main()
+{
+	TestShare();
+	TestIterators();
+	TestThreads();
+	TestBool();
+	return 0;
+}
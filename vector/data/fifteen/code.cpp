@@ -0,0 +1,130 @@
+#include "vector.hpp"
+#include "simd.hpp"
+#include "small_vector.hpp"
+
+#include <iostream>
+#include <vector>
+
+template<class V>
+void Print(const V &v)
+{
+	for (auto it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << *it;
+	}
+	std::cout << std::endl;
+}
+
+void TestBasic()
+{
+	std::cout << "Testing basic..." << std::endl;
+	sjtu::vector<bool> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	Print(v);
+	std::cout << v.size() << " " << v.capacity() << " " << v.word_count() << " " << v.count() << std::endl;
+	v[1] = true;
+	v[0] = v[2];
+	v[3].flip();
+	std::cout << v[0] << v[1] << v[2] << v[3] << " " << v.front() << v.back() << std::endl;
+	v.insert(0, true);
+	v.insert(v.size(), true);
+	v.insert(10, true);
+	Print(v);
+	v.erase(0);
+	v.erase(v.begin() + 9);
+	Print(v);
+	v.pop_back();
+	v.resize(30, true);
+	Print(v);
+	v.resize(25);
+	v.flip();
+	Print(v);
+	std::cout << v.count() << " " << sjtu::count(v, false) << " " << v.any() << v.none() << v.all() << std::endl;
+	try {
+		v.at(25);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	sjtu::vector<bool> w(v);
+	std::cout << (w == v) << " ";
+	w.pop_back();
+	std::cout << (w == v) << std::endl;
+	//a vector<bool> with another allocator is not packed
+	sjtu::small_vector<bool, 8> s;
+	s.push_back(true);
+	s.push_back(false);
+	std::cout << s.size() << " " << *s.data() << std::endl;
+}
+
+void TestWords()
+{
+	std::cout << "Testing word operations..." << std::endl;
+	const size_t n = 1000003;
+	sjtu::vector<bool> a(n, false), b;
+	std::vector<bool> ra(n, false), rb(n, false);
+	unsigned x = 12345;
+	for (size_t i = 0; i < n; ++i) {
+		x = x * 1103515245 + 12345;
+		if ((x >> 16) % 7 == 0) {
+			a[i] = true;
+			ra[i] = true;
+		}
+		b.push_back((x >> 20) % 5 == 0);
+		rb[i] = (x >> 20) % 5 == 0;
+	}
+	sjtu::vector<bool> c = a & b, d = a | b, e = a ^ b, f = ~a;
+	bool ok = true;
+	size_t ca = 0, cc = 0, cd = 0, ce = 0, cf = 0;
+	for (size_t i = 0; i < n; ++i) {
+		ok = ok && c[i] == (ra[i] && rb[i]) && d[i] == (ra[i] || rb[i]) && e[i] == (ra[i] != rb[i]) && f[i] == !ra[i];
+		ca += ra[i];
+		cc += ra[i] && rb[i];
+		cd += ra[i] || rb[i];
+		ce += ra[i] != rb[i];
+		cf += !ra[i];
+	}
+	std::cout << ok << " " << (a.count() == ca) << (c.count() == cc) << (d.count() == cd) << (e.count() == ce) << (f.count() == cf) << std::endl;
+	std::cout << a.count() << " " << c.count() << " " << f.count() << std::endl;
+	size_t seen = 0, last = 0;
+	ok = true;
+	for (size_t i = c.find_first(); i != c.size(); i = c.find_next(i)) {
+		ok = ok && c[i] && (seen == 0 || i > last);
+		last = i;
+		++seen;
+	}
+	std::cout << ok << " " << (seen == cc) << " " << c.find_next(n - 1) << std::endl;
+	try {
+		b.pop_back();
+		a &= b;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "size mismatch" << std::endl;
+	}
+	std::cout << sizeof(sjtu::vector<bool>::word_type) * a.word_count() << std::endl;
+}
+
+void TestAlgorithms()
+{
+	std::cout << "Testing simd algorithms..." << std::endl;
+	sjtu::vector<bool> v(200, false);
+	v[70] = true;
+	v[150] = true;
+	const sjtu::vector<bool> &cv = v;
+	std::cout << (sjtu::find(v, true) - v.begin()) << " " << (sjtu::find(cv, false) - cv.cbegin()) << std::endl;
+	std::cout << (sjtu::min_element(v) - v.begin()) << " " << (sjtu::max_element(cv) - cv.cbegin()) << std::endl;
+	std::cout << sjtu::accumulate(v, 10) << " " << sjtu::count(v, false) << std::endl;
+	sjtu::vector<bool> w = v;
+	std::cout << sjtu::equal(v, w);
+	w.flip();
+	std::cout << sjtu::equal(v, w) << " " << (sjtu::find(w, false) - w.begin()) << std::endl;
+	sjtu::vector<bool> all(65, true);
+	std::cout << (sjtu::find(all, false) - all.begin()) << " " << (sjtu::min_element(all) - all.begin()) << std::endl;
+}
+
+int main()
+{
+	TestBasic();
+	TestWords();
+	TestAlgorithms();
+	return 0;
+}
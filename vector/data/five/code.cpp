@@ -0,0 +1,94 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestReserve()
+{
+	std::cout << "Testing reserve and shrink_to_fit..." << std::endl;
+	sjtu::vector<int> v;
+	v.reserve(1000);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.reserve(10);
+	std::cout << v.capacity() << std::endl;
+	v.push_back(1000);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << " " << v.back() << std::endl;
+	while (!v.empty()) {
+		v.pop_back();
+	}
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+void TestResize()
+{
+	std::cout << "Testing resize..." << std::endl;
+	sjtu::vector<std::string> v;
+	v.resize(3);
+	std::cout << v.size() << " [" << v[0] << v[1] << v[2] << "]" << std::endl;
+	v.resize(6, "ab");
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << "[" << v[i] << "]";
+	}
+	std::cout << std::endl;
+	v.resize(40, v[5]);
+	std::cout << v.size() << " " << v[39] << std::endl;
+	v.resize(2);
+	std::cout << v.size() << " [" << v[1] << "]" << std::endl;
+	sjtu::vector<long long> w;
+	w.resize(100000, 7);
+	long long sum = 0;
+	for (size_t i = 0; i < w.size(); ++i) {
+		sum += w[i];
+	}
+	std::cout << sum << std::endl;
+}
+
+template <class Vector>
+void PrintCapacities(const char *name)
+{
+	Vector v;
+	std::cout << name << ":";
+	size_t last = v.capacity();
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+		if (v.capacity() != last) {
+			last = v.capacity();
+			std::cout << " " << last;
+		}
+	}
+	std::cout << std::endl;
+}
+
+void TestGrowthPolicy()
+{
+	std::cout << "Testing growth policies..." << std::endl;
+	PrintCapacities<sjtu::vector<int>>("default");
+	PrintCapacities<sjtu::vector<int, sjtu::growth_double>>("double");
+	PrintCapacities<sjtu::vector<int, sjtu::growth_one_and_half>>("one and half");
+	PrintCapacities<sjtu::vector<int, sjtu::growth_chunk<16>>>("chunk 16");
+	sjtu::vector<std::string, sjtu::growth_chunk<3>> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	v.insert(v.begin(), "x");
+	v.erase(v.begin() + 3);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i];
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestReserve();
+	TestResize();
+	TestGrowthPolicy();
+	return 0;
+}
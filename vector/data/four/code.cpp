@@ -0,0 +1,117 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+class Counter {
+public:
+	static int copies, moves;
+	int value;
+	Counter(int v = 0) : value(v) {}
+	Counter(int a, int b) : value(a * b) {}
+	Counter(const Counter &other) : value(other.value) { ++copies; }
+	Counter(Counter &&other) noexcept : value(other.value) { other.value = -1; ++moves; }
+	Counter &operator=(const Counter &other) { value = other.value; ++copies; return *this; }
+	Counter &operator=(Counter &&other) noexcept { value = other.value; other.value = -1; ++moves; return *this; }
+};
+int Counter::copies = 0;
+int Counter::moves = 0;
+
+void TestMoveConstructor()
+{
+	std::cout << "Testing move constructor and move assignment..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::string(20, 'a' + i));
+	}
+	sjtu::vector<std::string> w(std::move(v));
+	std::cout << v.size() << " " << w.size() << " " << w[9] << std::endl;
+	sjtu::vector<std::string> u;
+	u.push_back("old");
+	u = std::move(w);
+	std::cout << w.size() << " " << u.size() << " " << u[0] << std::endl;
+	for (sjtu::vector<std::string>::iterator it = u.begin(); it != u.end(); ++it) {
+		std::cout << (*it)[0];
+	}
+	std::cout << std::endl;
+	w.push_back("reuse");
+	std::cout << w.size() << " " << w.back() << std::endl;
+}
+
+void TestGrowthMoves()
+{
+	std::cout << "Testing reallocation moves elements..." << std::endl;
+	Counter::copies = Counter::moves = 0;
+	sjtu::vector<Counter> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.emplace_back(i);
+	}
+	std::cout << "copies: " << Counter::copies << std::endl;
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i].value;
+	}
+	std::cout << sum << std::endl;
+}
+
+void TestEmplace()
+{
+	std::cout << "Testing emplace and emplace_back..." << std::endl;
+	Counter::copies = Counter::moves = 0;
+	sjtu::vector<Counter> v;
+	v.emplace_back(3, 4);
+	v.emplace_back(5);
+	v.emplace(v.begin(), 6, 7);
+	v.emplace(v.begin() + 1, 8);
+	v.emplace(v.end(), 9, 9);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].value << " ";
+	}
+	std::cout << std::endl;
+	std::cout << "copies: " << Counter::copies << std::endl;
+	Counter c(100);
+	v.push_back(std::move(c));
+	v.insert(v.begin(), Counter(200));
+	std::cout << c.value << " " << v.front().value << " " << v.back().value << std::endl;
+	std::cout << "copies: " << Counter::copies << std::endl;
+}
+
+void TestSelfReference()
+{
+	std::cout << "Testing arguments referring into the vector..." << std::endl;
+	sjtu::vector<std::string> v;
+	v.push_back("first");
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(v[0]);
+		v.insert(v.begin(), v.back());
+	}
+	std::cout << v.size() << " " << v.front() << " " << v.back() << std::endl;
+}
+
+void TestMoveOnly()
+{
+	std::cout << "Testing move-only elements..." << std::endl;
+	sjtu::vector<std::unique_ptr<int>> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(std::unique_ptr<int>(new int(i)));
+	}
+	v.emplace(v.begin(), new int(-1));
+	v.erase(v.begin() + 50);
+	int sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += *v[i];
+	}
+	std::cout << v.size() << " " << sum << std::endl;
+}
+
+int main()
+{
+	TestMoveConstructor();
+	TestGrowthMoves();
+	TestEmplace();
+	TestSelfReference();
+	TestMoveOnly();
+	return 0;
+}
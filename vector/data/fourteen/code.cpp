@@ -0,0 +1,99 @@
+#include "soa_vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+struct Thrower {
+	static int countdown;
+	int x;
+	Thrower(int x = 0) : x(x) {
+		if (countdown >= 0 && countdown-- == 0)
+			throw 0;
+	}
+};
+int Thrower::countdown = -1;
+
+void TestBasic()
+{
+	std::cout << "Testing basic..." << std::endl;
+	sjtu::soa_vector<int, double, std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.emplace_back(i, i * 0.5, std::string(i, 'x'));
+	}
+	v.push_back(std::make_tuple(100, 1.5, std::string("last")));
+	std::cout << v.size() << " " << (v.capacity() >= 11) << std::endl;
+	std::cout << v[3].get<0>() << " " << v[3].get<1>() << " " << v[3].get<2>() << std::endl;
+	v[3].get<1>() = 9.25;
+	std::tuple<int, double, std::string> rec = v[3];
+	std::cout << std::get<1>(rec) << " " << (v[3] == rec) << std::endl;
+	v[0] = v[10];
+	std::cout << v[0].get<2>() << " " << v.back().get<0>() << std::endl;
+	v.erase(1);
+	v.erase(v.begin() + 5, v.begin() + 7);
+	v.insert(2, -1, -1.0, std::string("ins"));
+	for (auto it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << (*it).get<0>() << "," << (*it).get<2>() << " ";
+	}
+	std::cout << std::endl;
+	try {
+		v.at(v.size());
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	v.pop_back();
+	v.resize(10);
+	std::cout << v.size() << " " << v[9].get<0>() << " " << v[9].get<1>() << " [" << v[9].get<2>() << "]" << std::endl;
+}
+
+void TestFields()
+{
+	std::cout << "Testing fields..." << std::endl;
+	sjtu::soa_vector<int, int, char, long long> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.emplace_back(i % 97, i, 'a' + i % 26, (long long)i * i);
+	}
+	//a loop touching two of the four arrays
+	const int *score = v.data<0>();
+	const long long *weight = v.data<3>();
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += score[i] * (weight[i] % 1000);
+	}
+	std::cout << sum << std::endl;
+	std::sort(v.begin(), v.end(), [](const std::tuple<int, int, char, long long> &a, const std::tuple<int, int, char, long long> &b) {
+		return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : std::get<1>(a) < std::get<1>(b);
+	});
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		int k = v[i].get<1>();
+		ok = ok && v[i].get<0>() == k % 97 && v[i].get<2>() == 'a' + k % 26 && v[i].get<3>() == (long long)k * k;
+		ok = ok && (i == 0 || v[i - 1].get<0>() < v[i].get<0>() || v[i - 1].get<1>() < v[i].get<1>());
+	}
+	std::cout << ok << " " << v[0].get<1>() << " " << v[v.size() - 1].get<1>() << std::endl;
+}
+
+void TestThrow()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::soa_vector<std::string, Thrower> v;
+	for (int i = 0; i < 8; ++i) {
+		v.emplace_back(std::to_string(i), i);
+	}
+	Thrower::countdown = 0;
+	try {
+		v.emplace_back(std::string("bad"), 8);
+	} catch (int) {
+		std::cout << "thrown" << std::endl;
+	}
+	Thrower::countdown = -1;
+	std::cout << v.size() << " " << v.data<0>()[7] << " " << v.data<1>()[7].x << std::endl;
+}
+
+int main()
+{
+	TestBasic();
+	TestFields();
+	TestThrow();
+	return 0;
+}
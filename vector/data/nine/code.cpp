@@ -0,0 +1,101 @@
+#include "mmap_vector.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <iterator>
+
+struct Point {
+	int x, y;
+};
+
+const char *path = "mmap_vector.tmp";
+
+void TestCreate()
+{
+	std::cout << "Testing create..." << std::endl;
+	std::remove(path);
+	sjtu::mmap_vector<Point> v(path);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(Point{i, i * 2});
+	}
+	v.erase(v.begin(), v.begin() + 10);
+	v.insert(v.begin(), Point{-1, -2});
+	std::cout << v.size() << " " << v[0].x << " " << v[1].x << " " << v.back().y << std::endl;
+}
+
+void TestReopen()
+{
+	std::cout << "Testing reopen..." << std::endl;
+	{
+		sjtu::mmap_vector<Point> v(path);
+		std::cout << v.size() << " " << v[0].x << " " << v[1].x << " " << v.back().y << std::endl;
+		long long sum = 0;
+		for (sjtu::mmap_vector<Point>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+			sum += (*it).x;
+		}
+		std::cout << sum << std::endl;
+		v.resize(5);
+		v.shrink_to_fit();
+		v.sync();
+		std::cout << v.size() << " " << v.capacity() << std::endl;
+	}
+	sjtu::mmap_vector<Point> v(path);
+	std::cout << v.size() << " " << v.capacity() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i].x;
+	}
+	std::cout << std::endl;
+	v.clear();
+	v.push_back(Point{7, 7});
+}
+
+void TestMismatch()
+{
+	std::cout << "Testing mismatch..." << std::endl;
+	{
+		sjtu::mmap_vector<Point> v(path);
+		std::cout << v.size() << " " << v[0].x << std::endl;
+	}
+	try {
+		sjtu::mmap_vector<char> c(path);
+		std::cout << "opened" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "refused" << std::endl;
+	}
+	std::remove(path);
+}
+
+void TestSelfInsert()
+{
+	std::cout << "Testing self insert..." << std::endl;
+	std::remove(path);
+	{
+		sjtu::mmap_vector<int> v(path);
+		for (int i = 0; i < 4; ++i) {
+			v.push_back(i);
+		}
+		v.insert(v.begin(), v.begin(), v.end());
+		v.insert(v.begin() + 1, v.cbegin() + 6, v.cend());
+		std::istringstream in("7 8 9");
+		v.insert(v.begin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+		std::cout << v.size() << ":";
+		for (size_t i = 0; i < v.size(); ++i) {
+			std::cout << " " << v[i];
+		}
+		std::cout << std::endl;
+	}
+	sjtu::mmap_vector<int> v(path);
+	std::cout << v.size() << " " << v[0] << " " << v.back() << std::endl;
+	std::remove(path);
+}
+
+int main()
+{
+	TestCreate();
+	TestReopen();
+	TestMismatch();
+	TestSelfInsert();
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include "flat_map.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+void TestMap()
+{
+	std::cout << "Testing flat_map..." << std::endl;
+	std::vector<sjtu::pair<int, std::string>> table;
+	for (int i = 0; i < 10000; ++i) {
+		table.push_back(sjtu::pair<int, std::string>((i * 7919) % 10007, std::to_string(i)));
+	}
+	table.push_back(sjtu::pair<int, std::string>(0, "duplicate"));
+	sjtu::flat_map<int, std::string> m(table.begin(), table.end());
+	std::cout << m.size() << " " << m.at(0) << " " << m[7919] << " " << m.count(10006) << " " << m.count(5) << std::endl;
+	long long keys = 0;
+	for (auto it = m.cbegin(); it != m.cend(); ++it) {
+		keys += it->first;
+	}
+	std::cout << keys << " " << (m.end() - m.begin()) << std::endl;
+	auto r = m.insert(sjtu::pair<const int, std::string>(-1, "minus"));
+	std::cout << r.second << " " << (r.first == m.begin()) << " " << (*r.first).second << std::endl;
+	auto r2 = m.insert(sjtu::pair<const int, std::string>(-1, "again"));
+	std::cout << r2.second << " " << r2.first->second << std::endl;
+	m[20000] = "new";
+	std::cout << m.size() << " " << (--m.end())->second << std::endl;
+	std::cout << m.lower_bound(100)->first << " " << m.upper_bound(100)->first << std::endl;
+	m.erase(m.find(-1));
+	std::cout << m.erase(20000) << " " << m.erase(20000) << " " << m.size() << std::endl;
+	try {
+		m.at(20000);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "not found" << std::endl;
+	}
+	try {
+		m.erase(m.end());
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid iterator" << std::endl;
+	}
+	std::vector<sjtu::pair<int, std::string>> more;
+	for (int i = 0; i < 5; ++i) {
+		more.push_back(sjtu::pair<int, std::string>(10007 + i, "more"));
+		more.push_back(sjtu::pair<int, std::string>(i, "old"));
+	}
+	m.insert(more.begin(), more.end());
+	std::cout << m.size() << " " << m[1] << " " << m[10011] << std::endl;
+}
+
+void TestSet()
+{
+	std::cout << "Testing flat_set..." << std::endl;
+	int a[] = {5, 3, 9, 3, 1, 5, 7};
+	sjtu::flat_set<int> s(a, a + 7);
+	for (auto it = s.begin(); it != s.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << s.size() << std::endl;
+	std::cout << s.insert(4).second << " " << s.insert(4).second << " " << *s.lower_bound(6) << std::endl;
+	s.erase(s.find(1));
+	std::cout << s.erase(9) << " " << s.count(9) << " " << s.size() << " " << *s.begin() << std::endl;
+}
+
+int main()
+{
+	TestMap();
+	TestSet();
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include "small_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+template <class Vector>
+void Print(const Vector &v)
+{
+	std::cout << (v.is_inline() ? "inline" : "heap") << " " << v.size() << " " << v.capacity() << ":";
+	for (typename Vector::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << std::endl;
+}
+
+void TestInline()
+{
+	std::cout << "Testing inline storage..." << std::endl;
+	sjtu::small_vector<int, 8> v;
+	Print(v);
+	for (int i = 0; i < 8; ++i) {
+		v.push_back(i);
+	}
+	Print(v);
+	v.push_back(8);
+	Print(v);
+	v.erase(v.begin() + 2, v.end());
+	v.shrink_to_fit();
+	Print(v);
+	v.clear();
+	Print(v);
+}
+
+void TestStrings()
+{
+	std::cout << "Testing non-trivial elements..." << std::endl;
+	sjtu::small_vector<std::string, 4> v;
+	for (int i = 0; i < 4; ++i) {
+		v.emplace_back(std::string(i + 1, 'a' + i));
+	}
+	Print(v);
+	v.insert(v.begin() + 1, "xyz");
+	Print(v);
+	v.erase(v.begin(), v.begin() + 3);
+	v.shrink_to_fit();
+	Print(v);
+	v.insert(v.begin(), 2, "q");
+	Print(v);
+}
+
+void TestCopyAndMove()
+{
+	std::cout << "Testing copy and move..." << std::endl;
+	sjtu::small_vector<std::string, 4> a;
+	a.push_back("one");
+	a.push_back("two");
+	sjtu::small_vector<std::string, 4> b(a);
+	Print(b);
+	sjtu::small_vector<std::string, 4> c(std::move(a));
+	Print(a);
+	Print(c);
+	for (int i = 0; i < 6; ++i) {
+		b.push_back(std::to_string(i));
+	}
+	sjtu::small_vector<std::string, 4> d(std::move(b));
+	Print(b);
+	Print(d);
+	c = d;
+	Print(c);
+	d = std::move(c);
+	Print(c);
+	Print(d);
+	b.push_back("reuse");
+	Print(b);
+}
+
+void TestMany()
+{
+	std::cout << "Testing many small vectors..." << std::endl;
+	long long sum = 0;
+	for (int round = 0; round < 100000; ++round) {
+		sjtu::small_vector<int, 8> v;
+		for (int i = 0; i < round % 12; ++i) {
+			v.push_back(i + round);
+		}
+		for (size_t i = 0; i < v.size(); ++i) {
+			sum += v[i];
+		}
+	}
+	std::cout << sum << std::endl;
+}
+
+int main()
+{
+	TestInline();
+	TestStrings();
+	TestCopyAndMove();
+	TestMany();
+	return 0;
+}
@@ -0,0 +1,53 @@
+#define SJTU_STATS
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+struct Copyable {
+	int x;
+	Copyable(int x = 0) : x(x) {}
+	Copyable(const Copyable &other) : x(other.x) {}
+	Copyable &operator =(const Copyable &other) {
+		x = other.x;
+		return *this;
+	}
+};
+
+template<class V>
+void Print(const V &v)
+{
+	typename V::stats_type s = v.stats();
+	std::cout << s.reallocations << " " << s.bytes_moved << " " << s.copies << " " << s.moves << std::endl;
+}
+
+int main()
+{
+	std::cout << "Testing stats..." << std::endl;
+	sjtu::vector<std::string> a;
+	for (int i = 0; i < 100; ++i) {
+		a.push_back(std::to_string(i));
+	}
+	Print(a);
+	a.reset_stats();
+	a.insert(a.begin(), "front");
+	a.erase(a.begin() + 50);
+	Print(a);
+
+	//a copy constructor that may throw is used instead of moving
+	sjtu::vector<Copyable> b;
+	for (int i = 0; i < 100; ++i) {
+		b.push_back(Copyable(i));
+	}
+	Print(b);
+
+	sjtu::vector<int> c;
+	c.reserve(10);
+	for (int i = 0; i < 1000; ++i) {
+		c.push_back(i);
+	}
+	std::cout << c.stats().reallocations << " " << c.stats().copies << " " << c.stats().moves << std::endl;
+	sjtu::vector<int> d(c);
+	std::cout << d.stats().reallocations << std::endl;
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <list>
+#include <string>
+
+template <class Vector>
+void Print(const Vector &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestConstructors()
+{
+	std::cout << "Testing bulk constructors and assign..." << std::endl;
+	sjtu::vector<int> v(5, 3);
+	Print(v);
+	int a[] = {1, 2, 3, 4, 5, 6};
+	sjtu::vector<int> w(a, a + 6);
+	Print(w);
+	std::list<std::string> l;
+	l.push_back("x");
+	l.push_back("y");
+	l.push_back("z");
+	sjtu::vector<std::string> s(l.begin(), l.end());
+	Print(s);
+	s.assign(4, "w");
+	Print(s);
+	s.assign(l.begin(), l.end());
+	Print(s);
+	w.assign(v.begin(), v.end());
+	Print(w);
+}
+
+void TestRangeInsert()
+{
+	std::cout << "Testing range insert..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	int a[] = {-1, -2, -3};
+	v.insert(v.begin() + 5, a, a + 3);
+	Print(v);
+	v.insert(v.begin(), 2, 100);
+	Print(v);
+	v.insert(v.end(), v.begin(), v.begin() + 2);
+	Print(v);
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 5; ++i) {
+		s.push_back(std::string(i + 1, 'a' + i));
+	}
+	sjtu::vector<std::string> t(s);
+	s.insert(s.begin() + 2, t.begin(), t.end());
+	Print(s);
+	s.insert(s.begin() + 1, 3, s[0]);
+	Print(s);
+}
+
+void TestRangeErase()
+{
+	std::cout << "Testing range erase..." << std::endl;
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 10; ++i) {
+		s.push_back(std::to_string(i * i));
+	}
+	sjtu::vector<std::string>::iterator it = s.erase(s.begin() + 2, s.begin() + 5);
+	std::cout << *it << std::endl;
+	Print(s);
+	s.erase(s.begin(), s.begin());
+	s.erase(s.begin() + 4, s.end());
+	Print(s);
+	s.erase(s.begin(), s.end());
+	std::cout << s.size() << std::endl;
+}
+
+void TestSplice()
+{
+	std::cout << "Testing splicing batches into a sorted vector..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 100000; ++i) {
+		v.push_back(i * 2);
+	}
+	for (int batch = 0; batch < 200; ++batch) {
+		sjtu::vector<long long> b(1000, batch * 1000LL + 1);
+		v.insert(v.begin() + batch * 1000 + 1, b.begin(), b.end());
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << sum << std::endl;
+}
+
+int main()
+{
+	TestConstructors();
+	TestRangeInsert();
+	TestRangeErase();
+	TestSplice();
+	return 0;
+}
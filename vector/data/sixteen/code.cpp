@@ -0,0 +1,149 @@
+#include "vector.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+struct Point {
+	int x, y;
+	Point(int x, int y) : x(x), y(y) {}
+	Point(const Point &other) : x(other.x), y(other.y) {}
+};
+
+namespace sjtu {
+template<>
+struct serializer<Point> {
+	static void save(binary_writer &out, const Point &p) {
+		int a[2] = {p.x, p.y};
+		out.write(a, sizeof(a));
+	}
+	static Point load(binary_reader &in) {
+		int a[2];
+		in.read(a, sizeof(a));
+		return Point(a[0], a[1]);
+	}
+};
+}
+
+void TestStream()
+{
+	std::cout << "Testing streams..." << std::endl;
+	sjtu::vector<int> a;
+	for (int i = 0; i < 100000; ++i) {
+		a.push_back(i * 3);
+	}
+	sjtu::vector<std::string> b;
+	for (int i = 0; i < 100; ++i) {
+		b.push_back(std::string(i % 7, 'a' + i % 26));
+	}
+	sjtu::vector<Point> c;
+	c.push_back(Point(1, 2));
+	c.push_back(Point(3, 4));
+	sjtu::vector<sjtu::vector<int>> d(3, a);
+	sjtu::vector<bool> e;
+	for (int i = 0; i < 1000; ++i) {
+		e.push_back(i % 3 == 1);
+	}
+	std::stringstream ss;
+	a.save(ss);
+	b.save(ss);
+	c.save(ss);
+	d.save(ss);
+	e.save(ss);
+	std::cout << ss.str().size() << std::endl;
+
+	sjtu::vector<int> a2;
+	a2.push_back(-1);
+	sjtu::vector<std::string> b2;
+	sjtu::vector<Point> c2;
+	sjtu::vector<sjtu::vector<int>> d2;
+	sjtu::vector<bool> e2;
+	a2.load(ss);
+	b2.load(ss);
+	c2.load(ss);
+	d2.load(ss);
+	e2.load(ss);
+	bool ok = a2.size() == a.size() && b2.size() == b.size() && d2.size() == 3 && e2 == e;
+	for (size_t i = 0; i < a.size(); ++i) {
+		ok = ok && a2[i] == a[i] && d2[2][i] == a[i];
+	}
+	for (size_t i = 0; i < b.size(); ++i) {
+		ok = ok && b2[i] == b[i];
+	}
+	std::cout << ok << " " << c2.size() << " " << c2[1].x << " " << c2[1].y << " " << e2.count() << std::endl;
+
+	//another element type is refused
+	std::stringstream tt;
+	a.save(tt);
+	sjtu::vector<long long> f;
+	try {
+		f.load(tt);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "wrong type" << std::endl;
+	}
+	//so is a short input
+	std::stringstream short_input(ss.str().substr(0, 1000));
+	try {
+		a2.load(short_input);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "too short " << a2.size() << std::endl;
+	}
+	//and a count no memory could hold
+	std::stringstream big;
+	sjtu::vector<int>().save(big);
+	std::string header = big.str();
+	for (int i = 24; i < 32; ++i) {
+		header[i] = (char)(i == 31 ? 0x40 : 0);
+	}
+	std::stringstream corrupt(header);
+	try {
+		a2.load(corrupt);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "corrupt count" << std::endl;
+	}
+	std::stringstream bits;
+	sjtu::vector<bool>().save(bits);
+	header = bits.str();
+	for (int i = 24; i < 32; ++i) {
+		header[i] = (char)0xff;
+	}
+	std::stringstream corrupt_bits(header);
+	try {
+		e2.load(corrupt_bits);
+	} catch (sjtu::runtime_error &) {
+		std::cout << "corrupt count" << std::endl;
+	}
+}
+
+void TestFd()
+{
+	std::cout << "Testing file descriptors..." << std::endl;
+	char path[] = "/tmp/sjtu-serialize-XXXXXX";
+	int fd = mkstemp(path);
+	sjtu::vector<double> a;
+	for (int i = 0; i < 50000; ++i) {
+		a.push_back(i * 0.5);
+	}
+	sjtu::vector<std::string> b(20000, "text");
+	a.save(fd);
+	b.save(fd);
+	lseek(fd, 0, SEEK_SET);
+	sjtu::vector<double> a2;
+	sjtu::vector<std::string> b2;
+	a2.load(fd);
+	b2.load(fd);
+	std::cout << a2.size() << " " << a2[49999] << " " << b2.size() << " " << b2[19999] << std::endl;
+	close(fd);
+	unlink(path);
+}
+
+int main()
+{
+	TestStream();
+	TestFd();
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include "parallel.hpp"
+
+#include <iostream>
+#include <string>
+
+sjtu::vector<int> Random(int n)
+{
+	sjtu::vector<int> v;
+	unsigned int seed = 2333;
+	for (int i = 0; i < n; ++i) {
+		seed = seed * 1103515245 + 12345;
+		v.push_back((seed >> 8) % 1000000);
+	}
+	return v;
+}
+
+bool Sorted(const sjtu::vector<int> &v)
+{
+	for (size_t i = 1; i < v.size(); ++i) {
+		if (v[i] < v[i - 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestSort(sjtu::thread_pool &pool)
+{
+	std::cout << "Testing sort..." << std::endl;
+	for (int n : {0, 1, 100, 4097, 100000, 1000003}) {
+		sjtu::vector<int> v = Random(n);
+		long long sum = sjtu::parallel::reduce(pool, v.begin(), v.end(), 0LL);
+		sjtu::parallel::sort(pool, v.begin(), v.end());
+		std::cout << n << " " << Sorted(v) << " " << (sum == sjtu::parallel::reduce(pool, v.begin(), v.end(), 0LL));
+		if (n > 0) {
+			std::cout << " " << v[0] << " " << v[n / 2] << " " << v[n - 1];
+		}
+		std::cout << std::endl;
+	}
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 30000; ++i) {
+		s.push_back(std::to_string(i * 7919 % 30011));
+	}
+	sjtu::parallel::sort(pool, s.begin(), s.end(), [](const std::string &a, const std::string &b) {
+		return a.size() != b.size() ? a.size() > b.size() : a < b;
+	});
+	std::cout << s[0] << " " << s[1] << " " << s[29999] << std::endl;
+}
+
+void TestTransform(sjtu::thread_pool &pool)
+{
+	std::cout << "Testing transform and scan..." << std::endl;
+	sjtu::vector<int> v = Random(200000);
+	sjtu::vector<long long> w(v.size(), 0);
+	sjtu::parallel::transform(pool, v.begin(), v.end(), w.begin(), [](int x) { return (long long)x * x; });
+	std::cout << w[0] << " " << w[199999] << std::endl;
+	sjtu::parallel::inclusive_scan(pool, w.begin(), w.end(), w.begin());
+	long long sum = 0;
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += (long long)v[i] * v[i];
+		ok = ok && w[i] == sum;
+	}
+	std::cout << ok << " " << w[199999] << std::endl;
+	sjtu::parallel::for_each(pool, v.begin(), v.end(), [](int &x) { x %= 10; });
+	std::cout << sjtu::parallel::reduce(pool, v.begin(), v.end(), 0, [](int a, int b) { return a > b ? a : b; }) << std::endl;
+}
+
+void TestPool(sjtu::thread_pool &pool)
+{
+	std::cout << "Testing pool..." << std::endl;
+	std::cout << pool.size() << std::endl;
+	sjtu::vector<int> v(100000, 1);
+	v[77777] = 5;
+	try {
+		sjtu::parallel::for_each(pool, v.begin(), v.end(), [](int &x) {
+			if (x == 5) {
+				throw sjtu::runtime_error();
+			}
+		});
+		std::cout << "not thrown" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "thrown" << std::endl;
+	}
+	//a job started from inside a job runs on its own thread
+	sjtu::vector<long long> sums(8, 0);
+	pool.run(8, [&](size_t i) {
+		sums[i] = sjtu::parallel::reduce(pool, v.begin(), v.end(), 0LL);
+	});
+	std::cout << sums[0] << " " << sums[7] << std::endl;
+}
+
+int main()
+{
+	sjtu::thread_pool pool(4);
+	TestSort(pool);
+	TestTransform(pool);
+	TestPool(pool);
+	return 0;
+}
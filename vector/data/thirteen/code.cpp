@@ -0,0 +1,135 @@
+#include "concurrent_vector.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+void TestSingle()
+{
+	std::cout << "Testing single thread..." << std::endl;
+	sjtu::concurrent_vector<std::string> v;
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	std::cout << v.size() << " " << v.capacity() << " " << v[0] << " " << v[31] << " " << v[32] << " " << v.at(99) << std::endl;
+	const std::string *p = &v[5];
+	for (int i = 100; i < 10000; ++i) {
+		v.emplace_back(3, 'a' + i % 26);
+	}
+	std::cout << (p == &v[5]) << " " << *p << " " << v.size() << " " << v.capacity() << " " << v[9999] << std::endl;
+	try {
+		v.at(10000);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	size_t n = 0;
+	for (sjtu::concurrent_vector<std::string>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		n += it->size();
+	}
+	std::cout << n << std::endl;
+	v.clear();
+	v.reserve(1000);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+void TestThreads()
+{
+	std::cout << "Testing threads..." << std::endl;
+	const int producers = 8, each = 20000;
+	sjtu::concurrent_vector<long long> v;
+	std::atomic<bool> done(false);
+	std::atomic<long long> bad(0);
+	//the reader checks every element it is allowed to see
+	std::thread reader([&]() {
+		size_t seen = 0;
+		while (!done || seen < v.size()) {
+			size_t n = v.size();
+			for (; seen < n; ++seen) {
+				if (v[seen] < 0 || v[seen] >= producers * each) {
+					++bad;
+				}
+			}
+		}
+	});
+	std::vector<std::thread> ts;
+	for (int t = 0; t < producers; ++t) {
+		ts.emplace_back([&v, t]() {
+			for (int i = 0; i < each; ++i) {
+				v.push_back((long long)t * each + i);
+			}
+		});
+	}
+	for (size_t t = 0; t < ts.size(); ++t) {
+		ts[t].join();
+	}
+	done = true;
+	reader.join();
+	std::vector<int> count(producers * each, 0);
+	for (size_t i = 0; i < v.size(); ++i) {
+		++count[v[i]];
+	}
+	int missing = 0;
+	for (size_t i = 0; i < count.size(); ++i) {
+		missing += count[i] != 1;
+	}
+	std::cout << v.size() << " " << missing << " " << bad << std::endl;
+}
+
+int alive = 0;
+
+struct Fragile {
+	int x;
+	Fragile(int x) : x(x) {
+		if (x < 0) {
+			throw x;
+		}
+		++alive;
+	}
+	Fragile(const Fragile &other) : x(other.x) {
+		++alive;
+	}
+	~Fragile() {
+		--alive;
+	}
+};
+
+void TestThrow()
+{
+	std::cout << "Testing throw..." << std::endl;
+	{
+		sjtu::concurrent_vector<Fragile> v;
+		v.emplace_back(1);
+		try {
+			v.emplace_back(-1);
+		} catch (int) {
+			std::cout << "thrown" << std::endl;
+		}
+		v.emplace_back(3);
+		std::cout << v.size() << " " << v[0].x << " " << v[2].x << " " << alive << std::endl;
+		std::cout << v.valid(0) << v.valid(1) << v.valid(2) << v.valid(3);
+		for (sjtu::concurrent_vector<Fragile>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+			std::cout << " " << it->x;
+		}
+		std::cout << std::endl;
+		try {
+			v.at(1);
+		} catch (sjtu::runtime_error &) {
+			std::cout << "hole" << std::endl;
+		}
+		v.clear();
+		std::cout << alive << std::endl;
+		v.emplace_back(4);
+	}
+	std::cout << alive << std::endl;
+}
+
+int main()
+{
+	TestSingle();
+	TestThreads();
+	TestThrow();
+	return 0;
+}
@@ -0,0 +1,190 @@
+#include "persistent_vector.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <class Vector>
+void Print(const Vector &v)
+{
+	std::cout << v.size() << ":";
+	for (typename Vector::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << std::endl;
+}
+
+struct Thrower {
+	static int countdown, alive;
+	int x;
+	Thrower(int x = 0) : x(x) {
+		tick();
+		++alive;
+	}
+	Thrower(const Thrower &other) : x(other.x) {
+		tick();
+		++alive;
+	}
+	Thrower &operator =(const Thrower &) = default;
+	~Thrower() {
+		--alive;
+	}
+	static void tick() {
+		if (countdown >= 0 && countdown-- == 0)
+			throw 0;
+	}
+};
+int Thrower::countdown = -1;
+int Thrower::alive = 0;
+
+template <class Vector>
+long long Sum(const Vector &v)
+{
+	long long s = 0;
+	for (typename Vector::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		s += it->x;
+	}
+	return s;
+}
+
+void TestVersions()
+{
+	std::cout << "Testing versions..." << std::endl;
+	sjtu::persistent_vector<std::string> a;
+	sjtu::persistent_vector<std::string> b = a.push_back("x").push_back("y");
+	sjtu::persistent_vector<std::string> c = b.set(0, "z");
+	sjtu::persistent_vector<std::string> d = c.pop_back().push_back("w");
+	Print(a);
+	Print(b);
+	Print(c);
+	Print(d);
+	try {
+		b.at(2);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	try {
+		a.pop_back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty" << std::endl;
+	}
+}
+
+void TestLarge()
+{
+	std::cout << "Testing large..." << std::endl;
+	//snapshots of a vector growing past several levels of the trie
+	std::vector<sjtu::persistent_vector<int>> snapshots;
+	sjtu::persistent_vector<int> v;
+	for (int i = 0; i < 100000; ++i) {
+		v = std::move(v).push_back(i);
+		if (i % 10000 == 0) {
+			snapshots.push_back(v);
+		}
+	}
+	for (int i = 0; i < 100000; i += 7) {
+		v = v.set(i, -i);
+	}
+	long long sum = 0;
+	for (sjtu::persistent_vector<int>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		sum += *it;
+	}
+	std::cout << v.size() << " " << v[7] << " " << v[99999] << " " << sum << std::endl;
+	for (size_t k = 0; k < snapshots.size(); ++k) {
+		const sjtu::persistent_vector<int> &s = snapshots[k];
+		std::cout << s.size() << " " << s.front() << " " << s[s.size() / 2] << " " << s.back() << std::endl;
+	}
+	sjtu::persistent_vector<int> w = v;
+	while (w.size() > 31) {
+		w = std::move(w).pop_back();
+	}
+	Print(w);
+	std::cout << v.size() << " " << v.back() << std::endl;
+	sjtu::vector<int> src;
+	for (int i = 0; i < 40; ++i) {
+		src.push_back(i * i);
+	}
+	Print(sjtu::persistent_vector<int>(src.cbegin(), src.cend()));
+}
+
+void TestThreads()
+{
+	std::cout << "Testing threads..." << std::endl;
+	sjtu::persistent_vector<int> base;
+	for (int i = 0; i < 5000; ++i) {
+		base = base.push_back(i);
+	}
+	long long sums[4];
+	std::thread ts[4];
+	for (int t = 0; t < 4; ++t) {
+		ts[t] = std::thread([&base, &sums, t]() {
+			sjtu::persistent_vector<int> v = base;
+			for (int i = 0; i < 5000; i += 4) {
+				v = v.set(i, t);
+			}
+			for (int i = 0; i < 1000; ++i) {
+				v = v.pop_back();
+			}
+			long long s = 0;
+			for (size_t i = 0; i < v.size(); ++i) {
+				s += v[i];
+			}
+			sums[t] = s;
+		});
+	}
+	for (int t = 0; t < 4; ++t) {
+		ts[t].join();
+		std::cout << sums[t] << std::endl;
+	}
+	std::cout << base.size() << " " << base[4] << std::endl;
+}
+
+void TestThrow()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	{
+		sjtu::persistent_vector<Thrower> v;
+		for (int i = 0; i < 1024; ++i) {
+			v = std::move(v).push_back(Thrower(i));
+		}
+		sjtu::persistent_vector<Thrower> w = v;
+		int thrown = 0;
+		//every update copies the nodes it shares with w, and fails at each copy in turn
+		for (int k = 0; k < 40; ++k) {
+			Thrower t(-k);
+			Thrower::countdown = k;
+			try {
+				v = v.set(k * 10, t);
+			} catch (int) {
+				++thrown;
+			}
+			Thrower::countdown = k;
+			try {
+				v = v.push_back(t);
+			} catch (int) {
+				++thrown;
+			}
+			Thrower::countdown = k;
+			try {
+				v = v.pop_back().pop_back();
+			} catch (int) {
+				++thrown;
+			}
+			Thrower::countdown = -1;
+		}
+		std::cout << thrown << " " << v.size() << " " << Sum(v) << " " << v[100].x << std::endl;
+		std::cout << w.size() << " " << Sum(w) << " " << w[100].x << std::endl;
+	}
+	std::cout << Thrower::alive << std::endl;
+}
+
+int main()
+{
+	TestVersions();
+	TestLarge();
+	TestThreads();
+	TestThrow();
+	return 0;
+}
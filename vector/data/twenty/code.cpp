@@ -0,0 +1,66 @@
+#include "compressed_vector.hpp"
+
+#include <iostream>
+
+void TestSorted()
+{
+	std::cout << "Testing sorted..." << std::endl;
+	sjtu::vector<long long> ts;
+	long long t = 1700000000000LL;
+	for (int i = 0; i < 100000; ++i) {
+		t += (i * 37) % 1000;
+		ts.push_back(t);
+	}
+	sjtu::compressed_vector<long long> c(ts);
+	std::cout << c.size() << " " << c.delta() << " " << c.block_count() << " " << (ts.size() * sizeof(long long) / c.bytes()) << std::endl;
+	std::cout << c[0] << " " << c[12345] << " " << c.at(99999) << " " << c.back() << std::endl;
+	bool same = true;
+	for (size_t i = 0; i < ts.size(); ++i) {
+		same = same && c[i] == ts[i];
+	}
+	long long buf[sjtu::compressed_vector<long long>::block_size];
+	long long sum = 0;
+	for (size_t b = 0; b < c.block_count(); ++b) {
+		size_t n = c.decode_block(b, buf);
+		for (size_t i = 0; i < n; ++i) {
+			sum += buf[i] - 1700000000000LL;
+		}
+	}
+	std::cout << same << " " << sum << std::endl;
+	try {
+		c.at(100000);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+}
+
+void TestUnsorted()
+{
+	std::cout << "Testing unsorted..." << std::endl;
+	int a[1000];
+	for (int i = 0; i < 1000; ++i) {
+		a[i] = (i * 7919) % 1024 - 512;
+	}
+	a[500] = -2147483647 - 1;
+	sjtu::compressed_vector<int> c(a, 1000);
+	std::cout << c.size() << " " << c.delta() << " " << c[0] << " " << c[1] << " " << c[500] << " " << c[999] << std::endl;
+	sjtu::vector<int> v = c.to_vector();
+	bool same = true;
+	for (int i = 0; i < 1000; ++i) {
+		same = same && v[i] == a[i];
+	}
+	int n = 0;
+	for (auto it = c.cbegin(); it != c.cend(); ++it) {
+		n += *it < 0;
+	}
+	std::cout << same << " " << n << " " << (c.cend() - c.cbegin()) << std::endl;
+	sjtu::compressed_vector<int> e;
+	std::cout << e.size() << " " << e.bytes() << std::endl;
+}
+
+int main()
+{
+	TestSorted();
+	TestUnsorted();
+	return 0;
+}
@@ -0,0 +1,94 @@
+#include "vector.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+struct Counted {
+	int value;
+	Counted() : value(-1) {}
+};
+
+//hands out at most limit bytes of a message per call, like read() on a socket
+size_t receive(const std::string &message, size_t &offset, char *buf, size_t limit)
+{
+	size_t n = message.size() - offset < limit ? message.size() - offset : limit;
+	memcpy(buf, message.data() + offset, n);
+	offset += n;
+	return n;
+}
+
+void TestAppendUninitialized()
+{
+	std::cout << "Testing append_uninitialized..." << std::endl;
+	std::string message;
+	for (int i = 0; i < 500; ++i) {
+		message += "packet" + std::to_string(i) + ";";
+	}
+	sjtu::vector<char> buf;
+	size_t offset = 0, calls = 0;
+	while (true) {
+		char *p = buf.append_uninitialized(256);
+		size_t n = receive(message, offset, p, 256);
+		buf.commit_append(n);
+		++calls;
+		if (n == 0) {
+			break;
+		}
+	}
+	std::cout << buf.size() << " " << message.size() << " " << calls << " " << (buf.capacity() >= buf.size()) << std::endl;
+	std::cout << (std::string(buf.data(), buf.size()) == message) << std::endl;
+	//nothing committed, nothing changes
+	buf.append_uninitialized(100000);
+	std::cout << buf.size() << " " << (buf.capacity() >= buf.size() + 100000) << std::endl;
+	try {
+		buf.commit_append(buf.capacity() - buf.size() + 1);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+	sjtu::vector<int> ints;
+	ints.push_back(1);
+	int *q = ints.append_uninitialized(3);
+	q[0] = 2;
+	q[1] = 3;
+	ints.commit_append(2);
+	for (size_t i = 0; i < ints.size(); ++i) {
+		std::cout << ints[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestResizeDefaultInit()
+{
+	std::cout << "Testing resize_default_init..." << std::endl;
+	sjtu::vector<unsigned> v(4, 9);
+	v.resize_default_init(1000);
+	for (unsigned i = 4; i < 1000; ++i) {
+		v[i] = i;
+	}
+	unsigned long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << v.size() << " " << sum << std::endl;
+	v.resize_default_init(3);
+	std::cout << v.size() << " " << v[2] << std::endl;
+	//types with a default constructor still get it
+	sjtu::vector<Counted> c;
+	c.resize_default_init(5);
+	std::cout << c.size() << " " << c[0].value << " " << c[4].value << std::endl;
+	sjtu::vector<std::string> s;
+	s.push_back("kept");
+	s.resize_default_init(3);
+	std::cout << s.size() << " " << s[0] << " [" << s[2] << "]" << std::endl;
+	sjtu::vector<bool> b(10, true);
+	b.resize_default_init(100);
+	std::cout << b.size() << " " << b.count() << std::endl;
+}
+
+int main()
+{
+	TestAppendUninitialized();
+	TestResizeDefaultInit();
+	return 0;
+}
@@ -0,0 +1,198 @@
+#include "sort.hpp"
+
+#include <iostream>
+#include <string>
+
+struct Hit {
+	double score;
+	unsigned id;
+};
+
+unsigned long long seed = 20240607;
+unsigned next_rand()
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (unsigned)(seed >> 33);
+}
+
+void TestIntegral()
+{
+	std::cout << "Testing integral..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back((int)next_rand() - (1 << 30));
+	}
+	sjtu::vector<int> w = v;
+	sjtu::sort(v);
+	bool sorted = true;
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (i > 0 && v[i] < v[i - 1]) {
+			sorted = false;
+		}
+		sum += v[i];
+	}
+	for (size_t i = 0; i < w.size(); ++i) {
+		sum -= w[i];
+	}
+	std::cout << sorted << " " << sum << std::endl;
+	sjtu::sort(w, [](int a, int b) { return a > b; });
+	std::cout << (w[0] == v.back()) << " " << (w.back() == v[0]) << std::endl;
+	sjtu::vector<unsigned char> c;
+	for (int i = 0; i < 20; ++i) {
+		c.push_back((unsigned char)(next_rand() % 10));
+	}
+	sjtu::stable_sort(c);
+	for (size_t i = 0; i < c.size(); ++i) {
+		std::cout << (int)c[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestFloating()
+{
+	std::cout << "Testing floating..." << std::endl;
+	sjtu::vector<double> v;
+	double values[] = {3.5, -1.25, 0.0, -0.0, 1e300, -1e-300, 2.0, -7.5, 0.0, 100.0};
+	for (int r = 0; r < 40; ++r) {
+		for (double x : values) {
+			v.push_back(x * (r + 1));
+		}
+	}
+	sjtu::sort(v);
+	bool sorted = true;
+	for (size_t i = 1; i < v.size(); ++i) {
+		if (v[i] < v[i - 1]) {
+			sorted = false;
+		}
+	}
+	std::cout << v.size() << " " << sorted << " " << v[0] << " " << v[v.size() - 1] << std::endl;
+}
+
+void TestByKey()
+{
+	std::cout << "Testing sort_by_key..." << std::endl;
+	sjtu::vector<Hit> hits;
+	for (unsigned i = 0; i < 50000; ++i) {
+		hits.push_back(Hit{(double)(next_rand() % 1000) / 8, i});
+	}
+	//by descending score, ties keep ascending ids
+	sjtu::sort_by_key(hits, [](const Hit &h) { return -h.score; });
+	bool ok = true;
+	for (size_t i = 1; i < hits.size(); ++i) {
+		if (hits[i].score > hits[i - 1].score || (hits[i].score == hits[i - 1].score && hits[i].id < hits[i - 1].id)) {
+			ok = false;
+		}
+	}
+	std::cout << ok << " " << hits[0].score << " " << hits[hits.size() - 1].score << std::endl;
+	//a pair key sorts by score, then by id
+	sjtu::sort_by_key(hits, [](const Hit &h) { return sjtu::pair<double, unsigned>(h.score, h.id); });
+	ok = true;
+	for (size_t i = 1; i < hits.size(); ++i) {
+		if (hits[i].score < hits[i - 1].score || (hits[i].score == hits[i - 1].score && hits[i].id < hits[i - 1].id)) {
+			ok = false;
+		}
+	}
+	std::cout << ok << " " << hits[0].score << " " << hits[0].id << std::endl;
+	//keys a radix sort cannot take are compared
+	sjtu::vector<std::string> names;
+	std::string words[] = {"pear", "fig", "apple", "kiwi", "banana", "plum", "date"};
+	for (const std::string &w : words) {
+		names.push_back(w);
+	}
+	sjtu::sort_by_key(names, [](const std::string &s) { return s.size(); });
+	for (size_t i = 0; i < names.size(); ++i) {
+		std::cout << names[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::sort(names);
+	for (size_t i = 0; i < names.size(); ++i) {
+		std::cout << names[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestComparison()
+{
+	std::cout << "Testing comparison sorts..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 3000; ++i) {
+		v.push_back(std::to_string(next_rand() % 500));
+	}
+	sjtu::vector<std::string> sorted_input = v;
+	sjtu::sort(sorted_input);
+	sjtu::vector<std::string> w = sorted_input;
+	sjtu::sort(w);
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (w[i] != sorted_input[i] || (i > 0 && w[i] < w[i - 1])) {
+			ok = false;
+		}
+	}
+	std::cout << ok << " " << w[0] << " " << w[w.size() - 1] << std::endl;
+	sjtu::vector<std::pair<int, int>> p;
+	for (int i = 0; i < 1000; ++i) {
+		p.push_back(std::pair<int, int>((int)(next_rand() % 7), i));
+	}
+	sjtu::stable_sort(p, [](const std::pair<int, int> &a, const std::pair<int, int> &b) { return a.first < b.first; });
+	ok = true;
+	for (size_t i = 1; i < p.size(); ++i) {
+		if (p[i].first < p[i - 1].first || (p[i].first == p[i - 1].first && p[i].second < p[i - 1].second)) {
+			ok = false;
+		}
+	}
+	std::cout << ok << std::endl;
+}
+
+void TestNthElement()
+{
+	std::cout << "Testing nth_element..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10001; ++i) {
+		v.push_back((i * 7919) % 10001);
+	}
+	sjtu::nth_element(v, 5000);
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		if ((i < 5000 && v[i] > v[5000]) || (i > 5000 && v[i] < v[5000])) {
+			ok = false;
+		}
+	}
+	std::cout << v[5000] << " " << ok << std::endl;
+	sjtu::nth_element(v, 0, [](int a, int b) { return a > b; });
+	std::cout << v[0] << std::endl;
+	try {
+		sjtu::nth_element(v, v.size());
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "index_out_of_bound" << std::endl;
+	}
+}
+
+void TestBool()
+{
+	std::cout << "Testing vector<bool>..." << std::endl;
+	sjtu::vector<bool> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(next_rand() % 3 == 0);
+	}
+	size_t ones = v.count();
+	sjtu::sort(v);
+	bool ok = v.count() == ones && v.size() == 100;
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (v[i] != (i >= 100 - ones)) {
+			ok = false;
+		}
+	}
+	std::cout << ok << std::endl;
+}
+
+int main()
+{
+	TestIntegral();
+	TestFloating();
+	TestByKey();
+	TestComparison();
+	TestNthElement();
+	TestBool();
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestGrowth()
+{
+	std::cout << "Testing growth past the mapping threshold..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 1000000; ++i) {
+		v.push_back(i * 3);
+	}
+	bool same = true;
+	for (long long i = 0; i < 1000000; ++i) {
+		same = same && v[i] == i * 3;
+	}
+	std::cout << v.size() << " " << same << " " << (v.capacity() * sizeof(long long) >= SJTU_MMAP_THRESHOLD) << std::endl;
+	v.insert(v.begin(), 200000, -1);
+	v.erase(v.begin() + 1000, v.begin() + 201000);
+	std::cout << v.size() << " " << v[999] << " " << v[1000] << " " << v.back() << std::endl;
+	sjtu::vector<long long> w = v;
+	v.resize(100);
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << " " << v[99] << " " << w.size() << " " << w[999999] << std::endl;
+	w.reserve(10000000);
+	std::cout << w.capacity() << " " << w[0] << " " << w[999999] << std::endl;
+	v = std::move(w);
+	std::cout << v.size() << " " << w.size() << std::endl;
+}
+
+void TestObjects()
+{
+	std::cout << "Testing objects..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	size_t n = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		n += v[i].size();
+	}
+	std::cout << v.size() << " " << n << " " << v[54321] << std::endl;
+	v.clear();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+int main()
+{
+	TestGrowth();
+	TestObjects();
+	return 0;
+}
@@ -0,0 +1,105 @@
+#define SJTU_UNCHECKED
+
+#include "compressed_vector.hpp"
+#include "concurrent_vector.hpp"
+#include "cow_vector.hpp"
+#include "flat_map.hpp"
+#include "hive.hpp"
+#include "jagged_vector.hpp"
+#include "persistent_vector.hpp"
+#include "small_vector.hpp"
+#include "soa_vector.hpp"
+#include "static_vector.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+static_assert(!sjtu::checked_access, "unchecked");
+static_assert(sizeof(sjtu::vector<int>::iterator) == sizeof(int *), "bare iterator");
+static_assert(sizeof(sjtu::vector<int>::const_iterator) == sizeof(int *), "bare const_iterator");
+static_assert(sizeof(sjtu::vector<std::string>::iterator) == sizeof(std::string *), "bare iterator");
+static_assert(sizeof(sjtu::small_vector<int, 4>::iterator) == sizeof(int *), "bare iterator");
+
+void TestVector()
+{
+	std::cout << "Testing vector..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	v.insert(v.begin() + 10, -1);
+	v.erase(v.begin() + 20, v.begin() + 30);
+	long long sum = 0;
+	for (sjtu::vector<int>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		sum += *it;
+	}
+	std::cout << v.size() << " " << v[10] << " " << v[20] << " " << (v.end() - v.begin()) << " " << sum << std::endl;
+	try {
+		v.at(100);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at is checked" << std::endl;
+	}
+	sjtu::vector<bool> b(70, false);
+	b[69] = true;
+	std::cout << b.count() << " " << b[69] << " " << b[68] << std::endl;
+	sjtu::small_vector<int, 4> s;
+	for (int i = 0; i < 6; ++i) {
+		s.push_back(i * i);
+	}
+	std::cout << s[5] << " " << *(s.begin() + 2) << std::endl;
+}
+
+void TestOthers()
+{
+	std::cout << "Testing other containers..." << std::endl;
+	sjtu::static_vector<int, 8> sv(3, 7);
+	sv.push_back(8);
+	std::cout << sv[3] << " " << *sv.cbegin() << std::endl;
+	sjtu::flat_map<int, std::string> m;
+	m[3] = "three";
+	m[1] = "one";
+	std::cout << m[1] << " " << m.begin()->second << " " << m.size() << std::endl;
+	sjtu::hive<int> h;
+	for (int i = 0; i < 10; ++i) {
+		h.insert(i);
+	}
+	int hs = 0;
+	for (auto it = h.begin(); it != h.end(); ++it) {
+		hs += *it;
+	}
+	std::cout << h.size() << " " << hs << std::endl;
+	sjtu::jagged_vector<int> j;
+	int row[3] = {4, 5, 6};
+	j.push_row(row, row + 3);
+	std::cout << j[0][2] << " " << j[0].size() << std::endl;
+	sjtu::vector<long long> raw;
+	for (int i = 0; i < 300; ++i) {
+		raw.push_back(1000 + i * 3);
+	}
+	sjtu::compressed_vector<long long> c(raw);
+	std::cout << c[299] << std::endl;
+	sjtu::soa_vector<int, std::string> soa;
+	soa.emplace_back(1, std::string("a"));
+	std::cout << soa[0].get<1>() << std::endl;
+	sjtu::persistent_vector<int> p = sjtu::persistent_vector<int>().push_back(1).push_back(2);
+	std::cout << p[1] << " " << *p.cbegin() << std::endl;
+	sjtu::concurrent_vector<int> cv;
+	cv.push_back(9);
+	std::cout << cv[0] << " " << *cv.begin() << std::endl;
+	sjtu::cow_vector<int> w;
+	w.push_back(5);
+	std::cout << w[0] << std::endl;
+	try {
+		p.at(2);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at is checked" << std::endl;
+	}
+}
+
+int main()
+{
+	TestVector();
+	TestOthers();
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include "hive.hpp"
+
+#include <iostream>
+#include <string>
+
+struct Session {
+	int id;
+	std::string user;
+	Session(int i, const std::string &u) : id(i), user(u) {}
+};
+
+void TestChurn()
+{
+	std::cout << "Testing churn..." << std::endl;
+	sjtu::hive<Session> h;
+	sjtu::hive<Session>::iterator its[1000];
+	for (int i = 0; i < 1000; ++i) {
+		its[i] = h.emplace(i, "user" + std::to_string(i));
+	}
+	Session *keep = &*its[999];
+	std::cout << h.size() << " " << h.capacity() << std::endl;
+	for (int i = 0; i < 1000; i += 2) {
+		h.erase(its[i]);
+	}
+	for (int i = 1; i < 1000; i += 4) {
+		h.erase(its[i]);
+	}
+	std::cout << h.size() << " " << h.capacity() << " " << keep->id << " " << keep->user << std::endl;
+	long long sum = 0;
+	for (auto it = h.begin(); it != h.end(); ++it) {
+		sum += it->id;
+	}
+	std::cout << sum << std::endl;
+	for (int i = 0; i < 300; ++i) {
+		h.emplace(10000 + i, "new");
+	}
+	std::cout << h.size() << " " << h.capacity() << " " << keep->id << " " << (h.get_iterator(keep) == its[999]) << std::endl;
+	int n = 0;
+	sum = 0;
+	for (auto it = h.end(); it != h.begin(); ) {
+		--it;
+		++n;
+		sum += it->id;
+	}
+	std::cout << n << " " << sum << std::endl;
+}
+
+void TestErase()
+{
+	std::cout << "Testing erase..." << std::endl;
+	sjtu::hive<int> h;
+	for (int i = 0; i < 100; ++i) {
+		h.insert(i);
+	}
+	for (auto it = h.begin(); it != h.end(); ) {
+		if (*it % 3 != 0) {
+			it = h.erase(it);
+		} else {
+			++it;
+		}
+	}
+	for (auto it = h.cbegin(); it != h.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << h.size() << std::endl;
+	sjtu::hive<int> c = h;
+	for (auto it = h.begin(); it != h.end(); ) {
+		it = h.erase(it);
+	}
+	std::cout << h.size() << " " << h.capacity() << " " << c.size() << std::endl;
+	try {
+		h.erase(h.end());
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "invalid iterator" << std::endl;
+	}
+}
+
+int main()
+{
+	TestChurn();
+	TestErase();
+	return 0;
+}
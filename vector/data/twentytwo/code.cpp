@@ -0,0 +1,88 @@
+#include "jagged_vector.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+void TestGraph()
+{
+	std::cout << "Testing adjacency lists..." << std::endl;
+	const int n = 100000;
+	sjtu::jagged_vector<int, uint32_t>::builder b(n);
+	for (int u = 0; u < n; ++u) {
+		b.add(u, (u + 1) % n);
+		b.add((u * 7) % n, u);
+		if (u % 3 == 0) {
+			b.add(u, (u + 2) % n);
+		}
+	}
+	sjtu::jagged_vector<int, uint32_t> g = b.build();
+	std::cout << g.size() << " " << g.element_count() << " " << g.row_size(0) << " " << g.row_size(1) << std::endl;
+	long long sum = 0;
+	for (int u = 0; u < n; ++u) {
+		for (int v : g[u]) {
+			sum += (long long)u * v % 1000;
+		}
+	}
+	std::cout << sum << " " << g[7][0] << " " << g[7][1] << " " << g.at(99999).back() << std::endl;
+	std::cout << g.offsets().size() << " " << g.offsets()[n] << std::endl;
+	try {
+		g[5].at(10);
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+}
+
+void TestRows()
+{
+	std::cout << "Testing rows..." << std::endl;
+	sjtu::jagged_vector<std::string> j{{"a", "b"}, {}, {"c"}};
+	j.new_row();
+	j.push_back("d");
+	j.emplace_back(3, 'e');
+	std::string r[] = {"f", "g", "h"};
+	j.push_row(r, r + 3);
+	for (auto it = j.cbegin(); it != j.cend(); ++it) {
+		std::cout << "[";
+		for (const std::string &s : *it) {
+			std::cout << " " << s;
+		}
+		std::cout << " ]";
+	}
+	std::cout << std::endl;
+	j[0][1] = "B";
+	j.pop_row();
+	std::cout << j.size() << " " << j.element_count() << " " << j[0].back() << " " << j[1].empty() << " " << j.back().front() << std::endl;
+	j.clear();
+	try {
+		j.push_back("x");
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "no row" << std::endl;
+	}
+}
+
+void TestSelfCopy()
+{
+	std::cout << "Testing copying own rows..." << std::endl;
+	sjtu::jagged_vector<std::string> j;
+	j.push_row({"x", "y", "z"});
+	for (int i = 0; i < 10; ++i) {
+		j.push_row(j[i].begin(), j[i].end());
+	}
+	j.push_row(j[5].begin() + 1, j[5].end());
+	std::cout << j.size() << " " << j.element_count() << " " << j[10][2] << " " << j[11][0] << std::endl;
+	sjtu::jagged_vector<int> k;
+	k.push_row({1, 2});
+	for (int i = 0; i < 5; ++i) {
+		k.push_row(k.values().cbegin(), k.values().cend());
+	}
+	std::cout << k.size() << " " << k.element_count() << " " << k.row_size(5) << std::endl;
+}
+
+int main()
+{
+	TestGraph();
+	TestRows();
+	TestSelfCopy();
+	return 0;
+}
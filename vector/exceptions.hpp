@@ -38,6 +38,29 @@ class invalid_iterator : public exception {
 class container_is_empty : public exception {
 	/* __________________________ */
 };
+
+/**
+ * whether operator[] and iterators check their arguments and throw the exceptions above.
+ * define SJTU_UNCHECKED before including a container to compile the checks away,
+ * which also shrinks the iterators of vector and map to a bare pointer.
+ * at() is checked anyway.
+ */
+#ifdef SJTU_UNCHECKED
+constexpr bool checked_access = false;
+#else
+constexpr bool checked_access = true;
+#endif
+
+/**
+ * SJTU_STAT(expr) evaluates expr only if SJTU_STATS is defined.
+ * the containers count what they do inside with it, see their stats();
+ * without SJTU_STATS the counters and the counting are compiled away and stats() reads zeros.
+ */
+#ifdef SJTU_STATS
+#define SJTU_STAT(expr) ((void)(expr))
+#else
+#define SJTU_STAT(expr) ((void)0)
+#endif
 }
 
 #endif
@@ -0,0 +1,595 @@
+#ifndef SJTU_FLAT_MAP_HPP
+#define SJTU_FLAT_MAP_HPP
+
+#include "vector.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * the first of the n sorted keys at base which is not less than key.
+ * the loop halves the range without a branch on the comparison,
+ * which compiles to a conditional move, so it never mispredicts.
+ */
+template<class Key, class Compare>
+size_t _flat_lower_bound(const Key *base, size_t n, const Key &key, const Compare &comp) {
+    if (n == 0)
+        return 0;
+    const Key *first = base;
+    while (n > 1) {
+        size_t half = n / 2;
+        first = comp(first[half], key) ? first + half : first;
+        n -= half;
+    }
+    return (first - base) + (comp(*first, key) ? 1 : 0);
+}
+//the first of the n sorted keys at base which is greater than key
+template<class Key, class Compare>
+size_t _flat_upper_bound(const Key *base, size_t n, const Key &key, const Compare &comp) {
+    if (n == 0)
+        return 0;
+    const Key *first = base;
+    while (n > 1) {
+        size_t half = n / 2;
+        first = comp(key, first[half]) ? first : first + half;
+        n -= half;
+    }
+    return (first - base) + (comp(key, *first) ? 0 : 1);
+}
+
+/**
+ * a map kept as two sorted arrays, the keys in one sjtu::vector and the values in another.
+ * a lookup is a binary search over the keys alone, which touches O(log n) cache lines
+ * of one array instead of O(log n) scattered tree nodes; walking the map is a linear scan.
+ * inserting or erasing one element shifts the elements behind it, O(n),
+ * so build it with the range constructor or insert(first, last), which sort the new
+ * elements and merge them in O(n + m log m).
+ *
+ * the API is map's. as there is no stored pair<const Key, T>, the iterators give
+ * a pair<const Key &, T &> by value, and -> works through a proxy holding it.
+ * the iterators are random access; they and the references are invalidated by
+ * any insertion or erasure.
+ */
+template<
+	class Key,
+	class T,
+	class Compare = std::less<Key>
+>
+class flat_map {
+public:
+    using key_type          = Key;
+    using mapped_type       = T;
+    using value_type        = pair<const Key, T>;
+    using key_compare       = Compare;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using reference         = pair<const Key &, T &>;
+    using const_reference   = pair<const Key &, const T &>;
+    using key_container     = vector<Key, growth_double, _unpacked_allocator<Key>>;
+    using mapped_container  = vector<T, growth_double, _unpacked_allocator<T>>;
+
+private:
+    template<class InputIt>
+    using _if_iterator = typename std::enable_if<!std::is_integral<InputIt>::value>::type;
+
+    Compare comp;
+    key_container _keys;
+    mapped_container _values;
+
+public:
+    //what -> returns, a reference kept alive for the member access
+    template<class R>
+    struct _arrow {
+        R _ref;
+        R *operator ->() {
+            return &_ref;
+        }
+    };
+
+    /**
+     * a random access iterator, C is flat_map or const flat_map
+     */
+    template<class C, class R>
+    class _iterator {
+        friend class flat_map;
+        template<class C2, class R2>
+        friend class _iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = flat_map::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = _arrow<R>;
+        using reference         = R;
+    private:
+        C *_container = nullptr;
+        size_t _pos = 0;
+        _iterator(C *c, size_t pos) : _container(c), _pos(pos) {}
+    public:
+        _iterator() = default;
+        //an iterator converts to a const_iterator
+        template<class C2, class R2, class = typename std::enable_if<std::is_convertible<C2 *, C *>::value>::type>
+        _iterator(const _iterator<C2, R2> &other) : _container(other._container), _pos(other._pos) {}
+
+        R operator *() const {
+            return R(_container->_keys[_pos], _container->_values[_pos]);
+        }
+        _arrow<R> operator ->() const {
+            return _arrow<R>{**this};
+        }
+        R operator [](const difference_type &n) const {
+            return *(*this + n);
+        }
+        _iterator operator +(const difference_type &n) const {
+            return _iterator(_container, _pos + n);
+        }
+        _iterator operator -(const difference_type &n) const {
+            return _iterator(_container, _pos - n);
+        }
+        template<class C2, class R2>
+        difference_type operator -(const _iterator<C2, R2> &rhs) const {
+            if (checked_access && _container != rhs._container)
+                throw invalid_iterator();
+            return (difference_type)_pos - (difference_type)rhs._pos;
+        }
+        _iterator &operator +=(const difference_type &n) {
+            _pos += n;
+            return *this;
+        }
+        _iterator &operator -=(const difference_type &n) {
+            _pos -= n;
+            return *this;
+        }
+        _iterator &operator ++() {
+            if (checked_access && _pos >= _container->size())
+                throw invalid_iterator();
+            ++_pos;
+            return *this;
+        }
+        _iterator operator ++(int) {
+            _iterator t = *this;
+            ++*this;
+            return t;
+        }
+        _iterator &operator --() {
+            if (checked_access && _pos == 0)
+                throw invalid_iterator();
+            --_pos;
+            return *this;
+        }
+        _iterator operator --(int) {
+            _iterator t = *this;
+            --*this;
+            return t;
+        }
+        template<class C2, class R2>
+        bool operator ==(const _iterator<C2, R2> &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        template<class C2, class R2>
+        bool operator !=(const _iterator<C2, R2> &rhs) const {
+            return !(*this == rhs);
+        }
+        template<class C2, class R2>
+        bool operator <(const _iterator<C2, R2> &rhs) const {
+            return _pos < rhs._pos;
+        }
+    };
+    using iterator          = _iterator<flat_map, reference>;
+    using const_iterator    = _iterator<const flat_map, const_reference>;
+
+    flat_map() = default;
+    explicit flat_map(const Compare &c) : comp(c) {}
+    template<class InputIt, class = _if_iterator<InputIt>>
+    flat_map(InputIt first, InputIt last, const Compare &c = Compare()) : comp(c) {
+        insert(first, last);
+    }
+
+    T &at(const Key &key) {
+        size_type i = _find(key);
+        if (i == size())
+            throw index_out_of_bound();
+        return _values[i];
+    }
+    const T &at(const Key &key) const {
+        size_type i = _find(key);
+        if (i == size())
+            throw index_out_of_bound();
+        return _values[i];
+    }
+    T &operator [](const Key &key) {
+        size_type i = _lower_bound(key);
+        if (i == size() || comp(key, _keys[i]))
+            _insert_at(i, key, T());
+        return _values[i];
+    }
+    const T &operator [](const Key &key) const {
+        return at(key);
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, size());
+    }
+    const_iterator cend() const {
+        return const_iterator(this, size());
+    }
+
+    bool empty() const {
+        return _keys.empty();
+    }
+    size_type size() const {
+        return _keys.size();
+    }
+    void reserve(size_type n) {
+        _keys.reserve(n);
+        _values.reserve(n);
+    }
+    void clear() {
+        _keys.clear();
+        _values.clear();
+    }
+    //the sorted keys, and the values in the same order
+    const key_container &keys() const {
+        return _keys;
+    }
+    const mapped_container &values() const {
+        return _values;
+    }
+
+    //insert value if its key is not there yet
+    //return the element with the key, and whether value was inserted
+    pair<iterator, bool> insert(const value_type &value) {
+        size_type i = _lower_bound(value.first);
+        if (i < size() && !comp(value.first, _keys[i]))
+            return pair<iterator, bool>(iterator(this, i), false);
+        _insert_at(i, value.first, value.second);
+        return pair<iterator, bool>(iterator(this, i), true);
+    }
+    /**
+     * insert the elements of [first, last) whose keys are not there yet,
+     * of several elements with the same key the first one is taken.
+     * the new elements are sorted by themselves, then merged with the old ones
+     * into new arrays in one pass.
+     * if an exception is thrown the map is left as it was.
+     */
+    template<class InputIt, class = _if_iterator<InputIt>>
+    void insert(InputIt first, InputIt last) {
+        key_container nk;
+        mapped_container nv;
+        for (; first != last; ++first) {
+            nk.push_back((*first).first);
+            nv.push_back((*first).second);
+        }
+        size_type m = nk.size(), n = size();
+        if (m == 0)
+            return;
+        vector<size_t> order(m, 0);
+        for (size_type j = 0; j < m; ++j)
+            order[j] = j;
+        std::stable_sort(order.data(), order.data() + m, [&](size_t a, size_t b) {
+            return comp(nk[a], nk[b]);
+        });
+        key_container keys;
+        mapped_container values;
+        keys.reserve(n + m);
+        values.reserve(n + m);
+        //the old elements are moved only if that cannot throw, so they survive an exception
+        size_type i = 0, j = 0;
+        while (i < n || j < m) {
+            if (j == m || (i < n && !comp(nk[order[j]], _keys[i]))) {
+                if (j < m && !comp(_keys[i], nk[order[j]])) {
+                    ++j;
+                    continue;
+                }
+                keys.push_back(std::move_if_noexcept(_keys[i]));
+                values.push_back(std::move_if_noexcept(_values[i]));
+                ++i;
+            }
+            else {
+                size_type k = order[j++];
+                if (!keys.empty() && !comp(keys.back(), nk[k]))
+                    continue;
+                keys.push_back(std::move(nk[k]));
+                values.push_back(std::move(nv[k]));
+            }
+        }
+        _keys = std::move(keys);
+        _values = std::move(values);
+    }
+
+    void erase(iterator pos) {
+        if (checked_access && (pos._container != this || pos._pos >= size()))
+            throw invalid_iterator();
+        _keys.erase(pos._pos);
+        _values.erase(pos._pos);
+    }
+    //erase the element with key, return the number of elements erased
+    size_type erase(const Key &key) {
+        size_type i = _find(key);
+        if (i == size())
+            return 0;
+        _keys.erase(i);
+        _values.erase(i);
+        return 1;
+    }
+
+    size_type count(const Key &key) const {
+        return _find(key) == size() ? 0 : 1;
+    }
+    iterator find(const Key &key) {
+        return iterator(this, _find(key));
+    }
+    const_iterator find(const Key &key) const {
+        return const_iterator(this, _find(key));
+    }
+    //the first element whose key is not less than key
+    iterator lower_bound(const Key &key) {
+        return iterator(this, _lower_bound(key));
+    }
+    const_iterator lower_bound(const Key &key) const {
+        return const_iterator(this, _lower_bound(key));
+    }
+    //the first element whose key is greater than key
+    iterator upper_bound(const Key &key) {
+        return iterator(this, _flat_upper_bound(_keys.data(), size(), key, comp));
+    }
+    const_iterator upper_bound(const Key &key) const {
+        return const_iterator(this, _flat_upper_bound(_keys.data(), size(), key, comp));
+    }
+
+private:
+    size_type _lower_bound(const Key &key) const {
+        return _flat_lower_bound(_keys.data(), size(), key, comp);
+    }
+    //the index of key, or size() if it is not there
+    size_type _find(const Key &key) const {
+        size_type i = _lower_bound(key);
+        if (i < size() && !comp(key, _keys[i]))
+            return i;
+        return size();
+    }
+    //the key is taken back if the value cannot be inserted
+    template<class V>
+    void _insert_at(size_type i, const Key &key, V &&value) {
+        _keys.insert(i, key);
+        try {
+            _values.insert(i, std::forward<V>(value));
+        }
+        catch (...) {
+            _keys.erase(i);
+            throw;
+        }
+    }
+};
+
+/**
+ * a set kept as one sorted sjtu::vector, see flat_map.
+ * the elements cannot be changed through the iterators, so iterator is const_iterator.
+ */
+template<
+	class Key,
+	class Compare = std::less<Key>
+>
+class flat_set {
+public:
+    using key_type          = Key;
+    using value_type        = Key;
+    using key_compare       = Compare;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using key_container     = vector<Key, growth_double, _unpacked_allocator<Key>>;
+
+private:
+    template<class InputIt>
+    using _if_iterator = typename std::enable_if<!std::is_integral<InputIt>::value>::type;
+
+    Compare comp;
+    key_container _keys;
+
+public:
+    /**
+     * a random access iterator over the sorted keys
+     */
+    class const_iterator {
+        friend class flat_set;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = Key;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const Key *;
+        using reference         = const Key &;
+    private:
+        const flat_set *_container = nullptr;
+        size_t _pos = 0;
+        const_iterator(const flat_set *c, size_t pos) : _container(c), _pos(pos) {}
+    public:
+        const_iterator() = default;
+
+        const Key &operator *() const {
+            return _container->_keys[_pos];
+        }
+        const Key *operator ->() const {
+            return &**this;
+        }
+        const Key &operator [](const difference_type &n) const {
+            return *(*this + n);
+        }
+        const_iterator operator +(const difference_type &n) const {
+            return const_iterator(_container, _pos + n);
+        }
+        const_iterator operator -(const difference_type &n) const {
+            return const_iterator(_container, _pos - n);
+        }
+        difference_type operator -(const const_iterator &rhs) const {
+            if (checked_access && _container != rhs._container)
+                throw invalid_iterator();
+            return (difference_type)_pos - (difference_type)rhs._pos;
+        }
+        const_iterator &operator +=(const difference_type &n) {
+            _pos += n;
+            return *this;
+        }
+        const_iterator &operator -=(const difference_type &n) {
+            _pos -= n;
+            return *this;
+        }
+        const_iterator &operator ++() {
+            if (checked_access && _pos >= _container->size())
+                throw invalid_iterator();
+            ++_pos;
+            return *this;
+        }
+        const_iterator operator ++(int) {
+            const_iterator t = *this;
+            ++*this;
+            return t;
+        }
+        const_iterator &operator --() {
+            if (checked_access && _pos == 0)
+                throw invalid_iterator();
+            --_pos;
+            return *this;
+        }
+        const_iterator operator --(int) {
+            const_iterator t = *this;
+            --*this;
+            return t;
+        }
+        bool operator ==(const const_iterator &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        bool operator !=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator <(const const_iterator &rhs) const {
+            return _pos < rhs._pos;
+        }
+    };
+    using iterator = const_iterator;
+
+    flat_set() = default;
+    explicit flat_set(const Compare &c) : comp(c) {}
+    template<class InputIt, class = _if_iterator<InputIt>>
+    flat_set(InputIt first, InputIt last, const Compare &c = Compare()) : comp(c) {
+        insert(first, last);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, size());
+    }
+    const_iterator cend() const {
+        return const_iterator(this, size());
+    }
+
+    bool empty() const {
+        return _keys.empty();
+    }
+    size_type size() const {
+        return _keys.size();
+    }
+    void reserve(size_type n) {
+        _keys.reserve(n);
+    }
+    void clear() {
+        _keys.clear();
+    }
+    const key_container &keys() const {
+        return _keys;
+    }
+
+    pair<iterator, bool> insert(const Key &key) {
+        size_type i = _lower_bound(key);
+        if (i < size() && !comp(key, _keys[i]))
+            return pair<iterator, bool>(iterator(this, i), false);
+        _keys.insert(i, key);
+        return pair<iterator, bool>(iterator(this, i), true);
+    }
+    //insert the keys of [first, last) which are not there yet, see flat_map
+    template<class InputIt, class = _if_iterator<InputIt>>
+    void insert(InputIt first, InputIt last) {
+        key_container nk(first, last);
+        size_type m = nk.size(), n = size();
+        if (m == 0)
+            return;
+        std::stable_sort(nk.data(), nk.data() + m, comp);
+        key_container keys;
+        keys.reserve(n + m);
+        size_type i = 0, j = 0;
+        while (i < n || j < m) {
+            if (j == m || (i < n && !comp(nk[j], _keys[i]))) {
+                if (j < m && !comp(_keys[i], nk[j])) {
+                    ++j;
+                    continue;
+                }
+                keys.push_back(std::move_if_noexcept(_keys[i++]));
+            }
+            else {
+                if (!keys.empty() && !comp(keys.back(), nk[j])) {
+                    ++j;
+                    continue;
+                }
+                keys.push_back(std::move(nk[j++]));
+            }
+        }
+        _keys = std::move(keys);
+    }
+
+    void erase(const_iterator pos) {
+        if (checked_access && (pos._container != this || pos._pos >= size()))
+            throw invalid_iterator();
+        _keys.erase(pos._pos);
+    }
+    size_type erase(const Key &key) {
+        size_type i = _find(key);
+        if (i == size())
+            return 0;
+        _keys.erase(i);
+        return 1;
+    }
+
+    size_type count(const Key &key) const {
+        return _find(key) == size() ? 0 : 1;
+    }
+    const_iterator find(const Key &key) const {
+        return const_iterator(this, _find(key));
+    }
+    const_iterator lower_bound(const Key &key) const {
+        return const_iterator(this, _lower_bound(key));
+    }
+    const_iterator upper_bound(const Key &key) const {
+        return const_iterator(this, _flat_upper_bound(_keys.data(), size(), key, comp));
+    }
+
+private:
+    size_type _lower_bound(const Key &key) const {
+        return _flat_lower_bound(_keys.data(), size(), key, comp);
+    }
+    size_type _find(const Key &key) const {
+        size_type i = _lower_bound(key);
+        if (i < size() && !comp(key, _keys[i]))
+            return i;
+        return size();
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef SJTU_HIVE_HPP
+#define SJTU_HIVE_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * an unordered container with O(1) insert and erase whose elements never move,
+ * so pointers and references to them stay valid until they are erased (a colony).
+ * the elements live in blocks of 8, 16, ... up to 8192 slots, linked in iteration order.
+ * an erased slot is left as a hole and reused by a later insert; a block whose
+ * elements are all erased is freed.
+ *
+ * each block has a skip field, an sjtu::vector of one uint16_t per slot: 0 for an element,
+ * and for a run of holes its length, stored at both ends of the run.
+ * so ++ steps over a whole run in one jump, and -- likewise from the other end.
+ * the runs of a block are kept in a doubly linked list threaded through the holes themselves,
+ * and the blocks having runs in an sjtu::vector, which is where insert looks first.
+ */
+template<typename T>
+class hive {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc cannot align the elements");
+
+public:
+    using value_type        = T;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+private:
+    static constexpr size_t FIRST_BLOCK = 8;
+    static constexpr size_t MAX_BLOCK = 8192;
+    static constexpr uint16_t NONE = 0xffff;
+
+    //a hole at the head of a run holds the links of the list of runs
+    union _Slot {
+        T value;
+        struct {
+            uint16_t prev, next;
+        } links;
+        _Slot() {}
+        ~_Slot() {}
+    };
+    struct _Block {
+        _Slot *slots;
+        vector<uint16_t> skip;      //one more than the slots, the last entry is always 0
+        size_t capacity;
+        size_t high = 0;            //the slots from high on have never been used
+        size_t size = 0;
+        uint16_t free_head = NONE;  //the first run of holes
+        size_t hole_pos = (size_t)-1; //where the block is in _with_holes
+        _Block *prev = nullptr, *next = nullptr;
+
+        explicit _Block(size_t cap) : skip(cap + 1, 0), capacity(cap) {
+            slots = (_Slot *)malloc(sizeof(_Slot) * cap);
+            if (slots == nullptr)
+                throw std::bad_alloc();
+        }
+        ~_Block() {
+            free((void *)slots);
+        }
+    };
+
+    _Block *_first = nullptr, *_last = nullptr;
+    vector<_Block *> _with_holes;
+    size_type _size = 0;
+    size_type _capacity = 0;
+
+public:
+    /**
+     * a bidirectional iterator, V is T or const T
+     */
+    template<class V, class C>
+    class _iterator {
+        friend class hive;
+        template<class V2, class C2>
+        friend class _iterator;
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = V *;
+        using reference         = V &;
+    private:
+        C *_container = nullptr;
+        _Block *_block = nullptr; //nullptr at end()
+        size_t _idx = 0;
+        _iterator(C *c, _Block *b, size_t idx) : _container(c), _block(b), _idx(idx) {}
+    public:
+        _iterator() = default;
+        template<class V2, class C2, class = typename std::enable_if<std::is_convertible<V2 *, V *>::value>::type>
+        _iterator(const _iterator<V2, C2> &other) : _container(other._container), _block(other._block), _idx(other._idx) {}
+
+        V &operator *() const {
+            if (checked_access && _block == nullptr)
+                throw invalid_iterator();
+            return _block->slots[_idx].value;
+        }
+        V *operator ->() const {
+            return &**this;
+        }
+        _iterator &operator ++() {
+            if (checked_access && _block == nullptr)
+                throw invalid_iterator();
+            _idx += 1;
+            _idx += _block->skip[_idx];
+            if (_idx >= _block->high) {
+                _block = _block->next;
+                _idx = _block == nullptr ? 0 : _block->skip[0];
+            }
+            return *this;
+        }
+        _iterator operator ++(int) {
+            _iterator t = *this;
+            ++*this;
+            return t;
+        }
+        _iterator &operator --() {
+            _Block *b = _block == nullptr ? _container->_last : _block;
+            if (checked_access && b == nullptr)
+                throw invalid_iterator();
+            //i is the slot after the element sought, in block b
+            size_t i = _block == nullptr ? b->high : _idx;
+            while (true) {
+                if (i == 0) {
+                    b = b->prev;
+                    if (checked_access && b == nullptr)
+                        throw invalid_iterator();
+                    i = b->high;
+                }
+                i -= 1;
+                i -= b->skip[i] != 0 ? b->skip[i] - 1 : 0;
+                if (b->skip[i] == 0)
+                    break;
+            }
+            _block = b;
+            _idx = i;
+            return *this;
+        }
+        _iterator operator --(int) {
+            _iterator t = *this;
+            --*this;
+            return t;
+        }
+        template<class V2, class C2>
+        bool operator ==(const _iterator<V2, C2> &rhs) const {
+            return _block == rhs._block && _idx == rhs._idx;
+        }
+        template<class V2, class C2>
+        bool operator !=(const _iterator<V2, C2> &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+    using iterator          = _iterator<T, hive>;
+    using const_iterator    = _iterator<const T, const hive>;
+
+    hive() = default;
+    hive(const hive &other) {
+        for (const_iterator it = other.cbegin(); it != other.cend(); ++it)
+            insert(*it);
+    }
+    hive(hive &&other) noexcept {
+        swap(other);
+    }
+    template<class InputIt>
+    hive(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+    ~hive() {
+        clear();
+    }
+    hive &operator =(const hive &other) {
+        if (this != &other) {
+            hive t(other);
+            swap(t);
+        }
+        return *this;
+    }
+    hive &operator =(hive &&other) {
+        if (this != &other) {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+    void swap(hive &other) {
+        std::swap(_first, other._first);
+        std::swap(_last, other._last);
+        std::swap(_with_holes, other._with_holes);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+    //the slots of all the blocks
+    size_type capacity() const {
+        return _capacity;
+    }
+    void clear() {
+        while (_first != nullptr) {
+            _Block *b = _first;
+            _first = b->next;
+            for (size_t i = b->skip[0]; i < b->high; i += 1 + b->skip[i + 1])
+                b->slots[i].value.~T();
+            delete b;
+        }
+        _last = nullptr;
+        _with_holes.clear();
+        _size = _capacity = 0;
+    }
+
+    iterator begin() {
+        return iterator(this, _first, _first == nullptr ? 0 : _first->skip[0]);
+    }
+    iterator end() {
+        return iterator(this, nullptr, 0);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, _first, _first == nullptr ? 0 : _first->skip[0]);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, nullptr, 0);
+    }
+
+    //put the new element into a hole if there is one, otherwise behind the last element
+    template<class... Args>
+    iterator emplace(Args&&... args) {
+        if (!_with_holes.empty()) {
+            _Block *b = _with_holes.back();
+            size_t h = b->free_head;
+            _Slot *s = b->slots;
+            uint16_t next = s[h].links.next;
+            try {
+                new (&s[h].value) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                s[h].links.prev = NONE;
+                s[h].links.next = next;
+                throw;
+            }
+            size_t len = b->skip[h];
+            b->skip[h] = 0;
+            if (len == 1) {
+                b->free_head = next;
+                if (next != NONE)
+                    s[next].links.prev = NONE;
+            }
+            else {
+                //the run now begins one slot later
+                b->skip[h + 1] = b->skip[h + len - 1] = (uint16_t)(len - 1);
+                s[h + 1].links.prev = NONE;
+                s[h + 1].links.next = next;
+                if (next != NONE)
+                    s[next].links.prev = (uint16_t)(h + 1);
+                b->free_head = (uint16_t)(h + 1);
+            }
+            if (b->free_head == NONE)
+                _remove_holes(b);
+            ++b->size;
+            ++_size;
+            return iterator(this, b, h);
+        }
+        if (_last == nullptr || _last->high == _last->capacity)
+            _append_block();
+        _Block *b = _last;
+        try {
+            new (&b->slots[b->high].value) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            //no block is left empty
+            if (b->high == 0)
+                _free_block(b);
+            throw;
+        }
+        ++b->size;
+        ++_size;
+        return iterator(this, b, b->high++);
+    }
+    iterator insert(const T &value) {
+        return emplace(value);
+    }
+    iterator insert(T &&value) {
+        return emplace(std::move(value));
+    }
+
+    //erase the element at pos, return the element after it
+    iterator erase(const_iterator pos) {
+        if (checked_access && (pos._container != this || pos._block == nullptr))
+            throw invalid_iterator();
+        const_iterator nx = pos;
+        ++nx;
+        iterator r(this, nx._block, nx._idx);
+        _Block *b = pos._block;
+        size_t i = pos._idx;
+        b->slots[i].value.~T();
+        --_size;
+        if (--b->size == 0) {
+            _free_block(b);
+            return r;
+        }
+        _make_hole(b, i);
+        return r;
+    }
+    //the iterator of the element at p, which must be in the hive, found in O(blocks)
+    iterator get_iterator(const T *p) {
+        for (_Block *b = _first; b != nullptr; b = b->next) {
+            const _Slot *s = (const _Slot *)(const void *)p;
+            if (s >= b->slots && s < b->slots + b->high && b->skip[s - b->slots] == 0)
+                return iterator(this, b, s - b->slots);
+        }
+        throw invalid_iterator();
+    }
+
+private:
+    void _append_block() {
+        size_t cap = _last == nullptr ? FIRST_BLOCK : _last->capacity * 2;
+        if (cap > MAX_BLOCK)
+            cap = MAX_BLOCK;
+        _Block *b = new _Block(cap);
+        b->prev = _last;
+        if (_last != nullptr)
+            _last->next = b;
+        else
+            _first = b;
+        _last = b;
+        _capacity += cap;
+    }
+    void _free_block(_Block *b) {
+        if (b->hole_pos != (size_t)-1)
+            _remove_holes(b);
+        if (b->prev != nullptr)
+            b->prev->next = b->next;
+        else
+            _first = b->next;
+        if (b->next != nullptr)
+            b->next->prev = b->prev;
+        else
+            _last = b->prev;
+        _capacity -= b->capacity;
+        delete b;
+    }
+    //take b out of _with_holes, the last entry fills its place
+    void _remove_holes(_Block *b) {
+        _Block *t = _with_holes.back();
+        _with_holes[b->hole_pos] = t;
+        t->hole_pos = b->hole_pos;
+        _with_holes.pop_back();
+        b->hole_pos = (size_t)-1;
+    }
+    //the run beginning at h leaves the list of runs
+    static void _unlink(_Block *b, size_t h) {
+        _Slot *s = b->slots;
+        uint16_t prev = s[h].links.prev, next = s[h].links.next;
+        if (prev != NONE)
+            s[prev].links.next = next;
+        else
+            b->free_head = next;
+        if (next != NONE)
+            s[next].links.prev = prev;
+    }
+    //the run beginning at h joins the list of runs
+    void _link(_Block *b, size_t h) {
+        _Slot *s = b->slots;
+        s[h].links.prev = NONE;
+        s[h].links.next = b->free_head;
+        if (b->free_head != NONE)
+            s[b->free_head].links.prev = (uint16_t)h;
+        b->free_head = (uint16_t)h;
+        if (b->hole_pos == (size_t)-1) {
+            b->hole_pos = _with_holes.size();
+            _with_holes.push_back(b);
+        }
+    }
+    //slot i has become a hole, it joins the runs next to it
+    void _make_hole(_Block *b, size_t i) {
+        vector<uint16_t> &skip = b->skip;
+        bool left = i > 0 && skip[i - 1] != 0;
+        bool right = i + 1 < b->high && skip[i + 1] != 0;
+        if (left && right) {
+            size_t ll = skip[i - 1], rl = skip[i + 1];
+            _unlink(b, i + 1);
+            skip[i - ll] = skip[i + rl] = skip[i] = (uint16_t)(ll + 1 + rl);
+        }
+        else if (left) {
+            size_t ll = skip[i - 1];
+            skip[i - ll] = skip[i] = (uint16_t)(ll + 1);
+        }
+        else if (right) {
+            size_t rl = skip[i + 1];
+            _unlink(b, i + 1);
+            skip[i] = skip[i + rl] = (uint16_t)(rl + 1);
+            _link(b, i);
+        }
+        else {
+            skip[i] = 1;
+            _link(b, i);
+        }
+    }
+};
+
+}
+
+#endif
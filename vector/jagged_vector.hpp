@@ -0,0 +1,415 @@
+#ifndef SJTU_JAGGED_VECTOR_HPP
+#define SJTU_JAGGED_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a vector of rows of T packed into one buffer, as in the CSR format of sparse matrices.
+ * the elements of all the rows are kept one row after another in one sjtu::vector,
+ * and another one holds where each row begins, so a row costs one Index instead of
+ * a vector header and a malloc block of its own.
+ *
+ * rows are appended at the back: push_row() copies a whole row, and new_row() opens
+ * an empty row which push_back() then appends to. builder collects (row, value) pairs
+ * in any order and sorts them into rows in O(n).
+ * a row is handed out as a row_view, a pointer and a length: its iterators are plain
+ * pointers, and it is invalidated as soon as the jagged_vector grows.
+ * Index is the type of the offsets; uint32_t halves them if there are fewer than 2^32
+ * elements, appending more throws runtime_error.
+ */
+template<typename T, class Index = size_t>
+class jagged_vector {
+    static_assert(std::is_integral<Index>::value && std::is_unsigned<Index>::value,
+        "the offsets are unsigned integers");
+
+public:
+    using value_type        = T;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+private:
+    //a vector<bool> of them must not be packed, the rows point into it
+    using _values_type      = vector<T, growth_double, _unpacked_allocator<T>>;
+
+public:
+    /**
+     * the elements of one row, V is T or const T
+     */
+    template<class V>
+    class row_view {
+        friend class jagged_vector;
+        template<class V2>
+        friend class row_view;
+    public:
+        using value_type        = T;
+        using size_type         = size_t;
+        using iterator          = V *;
+    private:
+        V *_ptr = nullptr;
+        size_t _size = 0;
+        row_view(V *p, size_t n) : _ptr(p), _size(n) {}
+    public:
+        row_view() = default;
+        template<class V2, class = typename std::enable_if<std::is_convertible<V2 *, V *>::value>::type>
+        row_view(const row_view<V2> &other) : _ptr(other._ptr), _size(other._size) {}
+
+        V &at(const size_type &pos) const {
+            if (pos >= _size)
+                throw index_out_of_bound();
+            return _ptr[pos];
+        }
+        V &operator [](const size_type &pos) const {
+            if (checked_access && pos >= _size)
+                throw index_out_of_bound();
+            return _ptr[pos];
+        }
+        V &front() const {
+            if (_size == 0)
+                throw container_is_empty();
+            return _ptr[0];
+        }
+        V &back() const {
+            if (_size == 0)
+                throw container_is_empty();
+            return _ptr[_size - 1];
+        }
+        V *data() const {
+            return _ptr;
+        }
+        V *begin() const {
+            return _ptr;
+        }
+        V *end() const {
+            return _ptr + _size;
+        }
+        size_type size() const {
+            return _size;
+        }
+        bool empty() const {
+            return _size == 0;
+        }
+    };
+    using row           = row_view<T>;
+    using const_row     = row_view<const T>;
+
+    /**
+     * collects the elements of rows 0 .. rows - 1 in any order, build() makes the jagged_vector.
+     * the elements of one row keep the order they were added in.
+     */
+    class builder {
+        vector<Index> _counts;
+        vector<size_t> _rows;
+        _values_type _values;
+    public:
+        explicit builder(size_type rows) : _counts(rows, 0) {}
+        void add(size_type r, const T &value) {
+            if (r >= _counts.size())
+                throw index_out_of_bound();
+            _values.push_back(value);
+            _rows.push_back(r);
+            ++_counts[r];
+        }
+        void add(size_type r, T &&value) {
+            if (r >= _counts.size())
+                throw index_out_of_bound();
+            _values.push_back(std::move(value));
+            _rows.push_back(r);
+            ++_counts[r];
+        }
+        //a counting sort by row, the builder is left empty
+        jagged_vector build() {
+            jagged_vector j;
+            size_type n = _values.size(), rows = _counts.size();
+            _check(n);
+            j._offsets.resize(rows + 1);
+            for (size_type r = 0; r < rows; ++r)
+                j._offsets[r + 1] = j._offsets[r] + _counts[r];
+            //_counts becomes the next free slot of each row
+            for (size_type r = 0; r < rows; ++r)
+                _counts[r] = j._offsets[r];
+            //order[k] is the element going to slot k, so the slots are filled in order
+            vector<size_t> order(n, 0);
+            for (size_type i = 0; i < n; ++i)
+                order[_counts[_rows[i]]++] = i;
+            j._data.reserve(n);
+            for (size_type i = 0; i < n; ++i)
+                j._data.push_back(std::move(_values[order[i]]));
+            _values.clear();
+            _rows.clear();
+            _counts.assign(rows, 0);
+            return j;
+        }
+    };
+
+private:
+    _values_type _data;
+    vector<Index> _offsets; //row r is [_offsets[r], _offsets[r + 1]), there is always a leading 0
+
+    static void _check(size_t n) {
+        if (n > (size_t)std::numeric_limits<Index>::max())
+            throw runtime_error();
+    }
+
+public:
+    jagged_vector() : _offsets(1, 0) {}
+    //the rows of a vector of vectors, or of any range of ranges
+    template<class InputIt>
+    jagged_vector(InputIt first, InputIt last) : jagged_vector() {
+        for (; first != last; ++first)
+            push_row((*first).cbegin(), (*first).cend());
+    }
+    jagged_vector(std::initializer_list<std::initializer_list<T>> rows) : jagged_vector() {
+        for (const std::initializer_list<T> &r : rows)
+            push_row(r);
+    }
+
+    //the number of rows
+    size_type size() const {
+        return _offsets.size() - 1;
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+    //the number of elements in all the rows
+    size_type element_count() const {
+        return _data.size();
+    }
+    size_type row_size(const size_type &r) const {
+        if (r >= size())
+            throw index_out_of_bound();
+        return _offsets[r + 1] - _offsets[r];
+    }
+
+    row at(const size_type &r) {
+        if (r >= size())
+            throw index_out_of_bound();
+        return _row(r);
+    }
+    const_row at(const size_type &r) const {
+        if (r >= size())
+            throw index_out_of_bound();
+        return _row(r);
+    }
+    row operator [](const size_type &r) {
+        if (checked_access && r >= size())
+            throw index_out_of_bound();
+        return _row(r);
+    }
+    const_row operator [](const size_type &r) const {
+        if (checked_access && r >= size())
+            throw index_out_of_bound();
+        return _row(r);
+    }
+    row back() {
+        if (empty())
+            throw container_is_empty();
+        return _row(size() - 1);
+    }
+    const_row back() const {
+        if (empty())
+            throw container_is_empty();
+        return _row(size() - 1);
+    }
+
+    //the elements of all the rows, and where each row begins, with the end as the last entry
+    const _values_type &values() const {
+        return _data;
+    }
+    const vector<Index> &offsets() const {
+        return _offsets;
+    }
+
+    void reserve(size_type rows, size_type elements) {
+        _offsets.reserve(rows + 1);
+        _data.reserve(elements);
+    }
+    void shrink_to_fit() {
+        _offsets.shrink_to_fit();
+        _data.shrink_to_fit();
+    }
+    void clear() {
+        _data.clear();
+        _offsets.erase(_offsets.begin() + 1, _offsets.end());
+    }
+
+    //append a row holding [first, last), which may be a row of this jagged_vector
+    template<class InputIt>
+    void push_row(InputIt first, InputIt last) {
+        _push_row(first, last, typename iterator_traits<InputIt>::iterator_category());
+    }
+    void push_row(std::initializer_list<T> r) {
+        push_row(r.begin(), r.end());
+    }
+    //append an empty row, which push_back() appends to
+    void new_row() {
+        _offsets.push_back(_offsets.back());
+    }
+    //append to the last row
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        if (empty())
+            throw container_is_empty();
+        _check(_data.size() + 1);
+        _data.emplace_back(std::forward<Args>(args)...);
+        ++_offsets[size()];
+    }
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+    void pop_row() {
+        if (empty())
+            throw container_is_empty();
+        _offsets.pop_back();
+        _data.erase(_data.begin() + _offsets.back(), _data.end());
+    }
+
+    /**
+     * a random access iterator over the rows, giving row views by value
+     */
+    template<class C, class R>
+    class _iterator {
+        friend class jagged_vector;
+        template<class C2, class R2>
+        friend class _iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = R;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const R *;
+        using reference         = R;
+    private:
+        C *_container = nullptr;
+        size_t _pos = 0;
+        _iterator(C *c, size_t pos) : _container(c), _pos(pos) {}
+    public:
+        _iterator() = default;
+        template<class C2, class R2, class = typename std::enable_if<std::is_convertible<C2 *, C *>::value>::type>
+        _iterator(const _iterator<C2, R2> &other) : _container(other._container), _pos(other._pos) {}
+
+        R operator *() const {
+            return (*_container)[_pos];
+        }
+        R operator [](const difference_type &n) const {
+            return (*_container)[_pos + n];
+        }
+        _iterator operator +(const difference_type &n) const {
+            return _iterator(_container, _pos + n);
+        }
+        _iterator operator -(const difference_type &n) const {
+            return _iterator(_container, _pos - n);
+        }
+        template<class C2, class R2>
+        difference_type operator -(const _iterator<C2, R2> &rhs) const {
+            if (checked_access && _container != rhs._container)
+                throw invalid_iterator();
+            return (difference_type)_pos - (difference_type)rhs._pos;
+        }
+        _iterator &operator +=(const difference_type &n) {
+            _pos += n;
+            return *this;
+        }
+        _iterator &operator -=(const difference_type &n) {
+            _pos -= n;
+            return *this;
+        }
+        _iterator &operator ++() {
+            ++_pos;
+            return *this;
+        }
+        _iterator operator ++(int) {
+            _iterator t = *this;
+            ++_pos;
+            return t;
+        }
+        _iterator &operator --() {
+            --_pos;
+            return *this;
+        }
+        _iterator operator --(int) {
+            _iterator t = *this;
+            --_pos;
+            return t;
+        }
+        template<class C2, class R2>
+        bool operator ==(const _iterator<C2, R2> &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        template<class C2, class R2>
+        bool operator !=(const _iterator<C2, R2> &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+    using iterator          = _iterator<jagged_vector, row>;
+    using const_iterator    = _iterator<const jagged_vector, const_row>;
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, size());
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, size());
+    }
+
+private:
+    //the range is read in place only if _data will not move, it may lie inside _data
+    template<class ForwardIt>
+    void _push_row(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+        size_type n = std::distance(first, last);
+        if (n <= _data.capacity() - _data.size())
+            _append_row(first, last);
+        else
+            _push_row_copy(_values_type(first, last));
+    }
+    template<class InputIt>
+    void _push_row(InputIt first, InputIt last, std::input_iterator_tag) {
+        _push_row_copy(_values_type(first, last));
+    }
+    void _push_row_copy(_values_type &&tmp) {
+        size_type n = _data.size() + tmp.size(), cap = _data.capacity() * 2;
+        _data.reserve(cap > n ? cap : n);
+        _append_row(std::make_move_iterator(tmp.data()), std::make_move_iterator(tmp.data() + tmp.size()));
+    }
+    template<class InputIt>
+    void _append_row(InputIt first, InputIt last) {
+        size_type n = _data.size();
+        try {
+            for (; first != last; ++first) {
+                _check(_data.size() + 1);
+                _data.push_back(*first);
+            }
+            _offsets.push_back((Index)_data.size());
+        }
+        catch (...) {
+            _data.erase(_data.begin() + n, _data.end());
+            throw;
+        }
+    }
+
+    row _row(size_type r) {
+        return row(_data.data() + _offsets[r], _offsets[r + 1] - _offsets[r]);
+    }
+    const_row _row(size_type r) const {
+        return const_row(_data.data() + _offsets[r], _offsets[r + 1] - _offsets[r]);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef SJTU_MMAP_VECTOR_HPP
+#define SJTU_MMAP_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sjtu {
+
+/**
+ * an allocator whose single block is a file mapped into memory.
+ * the file starts with a header of 64 bytes, the elements follow it,
+ * and the file is always as long as the header plus the capacity.
+ * growing and shrinking go through ftruncate and mremap, so the block may move
+ * but its bytes are never copied by hand.
+ * it is for mmap_vector only: it hands out one block at a time and cannot be copied.
+ */
+template<class T>
+class mmap_allocator {
+public:
+    using value_type    = T;
+    using pointer       = T *;
+    using size_type     = size_t;
+
+    static constexpr size_t header = 64;
+
+private:
+    struct _Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t elem_size;
+        uint64_t size; //elements in use, written by the vector
+    };
+    static_assert(sizeof(_Header) <= header, "the header does not fit");
+    static_assert(alignof(T) <= header, "the elements would be misaligned");
+
+    int _fd = -1;
+    char *_base = nullptr; //the header followed by the elements
+    size_t _bytes = 0;
+
+public:
+    mmap_allocator() {}
+    mmap_allocator(const mmap_allocator &) = delete;
+    mmap_allocator(mmap_allocator &&other) : _fd(other._fd), _base(other._base), _bytes(other._bytes) {
+        other._fd = -1;
+        other._base = nullptr;
+        other._bytes = 0;
+    }
+    mmap_allocator &operator =(const mmap_allocator &) = delete;
+    ~mmap_allocator() {
+        close();
+    }
+
+    //map the file at path, creating it if it does not exist
+    //throw runtime_error if it cannot be opened or holds another kind of elements
+    void open(const char *path) {
+        close();
+        _fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (_fd < 0)
+            throw runtime_error();
+        struct stat st;
+        if (fstat(_fd, &st) != 0) {
+            close();
+            throw runtime_error();
+        }
+        size_t _len = (size_t)st.st_size;
+        if (_len == 0) {
+            if (ftruncate(_fd, (off_t)header) != 0) {
+                close();
+                throw runtime_error();
+            }
+            _map(header);
+            _Header *h = _head();
+            memcpy(h->magic, "SJTUVEC", 8);
+            h->version = 1;
+            h->elem_size = sizeof(T);
+            h->size = 0;
+            return;
+        }
+        if (_len < header) {
+            close();
+            throw runtime_error();
+        }
+        _map(_len);
+        _Header *h = _head();
+        if (memcmp(h->magic, "SJTUVEC", 8) != 0 || h->version != 1 || h->elem_size != sizeof(T)) {
+            close();
+            throw runtime_error();
+        }
+    }
+    void close() {
+        if (_base != nullptr)
+            munmap(_base, _bytes);
+        if (_fd >= 0)
+            ::close(_fd);
+        _fd = -1;
+        _base = nullptr;
+        _bytes = 0;
+    }
+
+    T *data() const {
+        return capacity() == 0 ? nullptr : (T *)(_base + header);
+    }
+    size_type capacity() const {
+        return _base == nullptr ? 0 : (_bytes - header) / sizeof(T);
+    }
+    //the size recorded in the file, never more than the capacity
+    size_type stored_size() const {
+        if (_base == nullptr)
+            return 0;
+        size_type n = (size_type)_head()->size;
+        return n < capacity() ? n : capacity();
+    }
+    void store_size(size_type n) {
+        if (_base != nullptr)
+            _head()->size = n;
+    }
+    //write the mapped pages back to the file
+    void sync() {
+        if (_base != nullptr)
+            msync(_base, _bytes, MS_SYNC);
+    }
+
+    T *allocate(size_type n) {
+        return reallocate(nullptr, 0, n);
+    }
+    void deallocate(T *p, size_type n) {
+        reallocate(p, n, 0);
+    }
+    T *reallocate(T *p, size_type n, size_type cap) {
+        (void)p;
+        (void)n;
+        if (_fd < 0)
+            throw std::bad_alloc();
+        _resize(header + sizeof(T) * cap);
+        if (stored_size() < _head()->size)
+            _head()->size = stored_size();
+        return data();
+    }
+
+    bool operator ==(const mmap_allocator &other) const {
+        return this == &other;
+    }
+    bool operator !=(const mmap_allocator &other) const {
+        return this != &other;
+    }
+
+private:
+    _Header *_head() const {
+        return (_Header *)_base;
+    }
+    void _map(size_t bytes) {
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED) {
+            close();
+            throw runtime_error();
+        }
+        _base = (char *)p;
+        _bytes = bytes;
+    }
+    //the file is extended before the mapping and cut after it
+    void _resize(size_t bytes) {
+        if (bytes == _bytes)
+            return;
+        if (bytes > _bytes && ftruncate(_fd, (off_t)bytes) != 0)
+            throw std::bad_alloc();
+#ifdef MREMAP_MAYMOVE
+        void *p = mremap(_base, _bytes, bytes, MREMAP_MAYMOVE);
+#else
+        munmap(_base, _bytes);
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+#endif
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        _base = (char *)p;
+        _bytes = bytes;
+        if (ftruncate(_fd, (off_t)bytes) != 0)
+            throw std::bad_alloc();
+    }
+};
+
+/**
+ * a vector kept in a file.
+ * opening it maps the file, so the elements are paged in when they are touched
+ * instead of being read up front, and whatever is pushed is written back by the kernel.
+ * the size is recorded in the file by sync() and the destructor;
+ * sync() also flushes the elements, otherwise they reach the disk whenever the kernel decides.
+ * T must be trivially copyable, as its bytes are all that is kept.
+ * the interface is that of sjtu::vector, except it cannot be copied or assigned.
+ */
+template<typename T, class Growth = growth_double>
+class mmap_vector : public vector<T, Growth, mmap_allocator<T>> {
+    static_assert(std::is_trivially_copyable<T>::value, "only the bytes of the elements are kept");
+    using _base = vector<T, Growth, mmap_allocator<T>>;
+
+public:
+    //open the vector stored at path, or create an empty one
+    explicit mmap_vector(const char *path) {
+        this->_alloc.open(path);
+        this->_set_storage(this->_alloc.data(), this->_alloc.stored_size(), this->_alloc.capacity());
+    }
+    mmap_vector(const mmap_vector &) = delete;
+    mmap_vector(mmap_vector &&other) = default;
+    mmap_vector &operator =(const mmap_vector &) = delete;
+    mmap_vector &operator =(mmap_vector &&) = delete;
+    //record the size and leave the storage to the file
+    ~mmap_vector() {
+        this->_alloc.store_size(this->size());
+        this->_set_storage(nullptr, 0, 0);
+    }
+
+    //record the size and write everything to the disk
+    void sync() {
+        this->_alloc.store_size(this->size());
+        this->_alloc.sync();
+    }
+};
+
+}
+
+#endif
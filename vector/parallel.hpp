@@ -0,0 +1,380 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a fixed set of threads running one job at a time.
+ * a job is f(0), f(1), ..., f(n - 1) handed out to the workers and the calling thread,
+ * and run() returns once all of them are done.
+ * the first exception thrown by f is rethrown by run().
+ * run() called from inside a job runs serially instead of waiting for the busy pool.
+ */
+class thread_pool {
+private:
+    vector<std::thread> _workers;
+    std::mutex _run_mutex; //one job at a time
+    std::mutex _mutex;
+    std::condition_variable _wake, _done;
+    const std::function<void(size_t)> *_job = nullptr;
+    size_t _count = 0;
+    std::atomic<size_t> _next;
+    size_t _busy = 0; //workers still on the job
+    size_t _generation = 0;
+    bool _stop = false;
+    std::exception_ptr _error;
+
+public:
+    //threads counts the calling thread, 0 for one per hardware thread
+    explicit thread_pool(size_t threads = 0) : _next(0) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        for (size_t i = 1; i < threads; ++i)
+            _workers.push_back(std::thread([this] { _loop(); }));
+    }
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator =(const thread_pool &) = delete;
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (size_t i = 0; i < _workers.size(); ++i)
+            _workers[i].join();
+    }
+
+    //the number of threads running a job, the calling one included
+    size_t size() const {
+        return _workers.size() + 1;
+    }
+
+    template<class F>
+    void run(size_t n, F f) {
+        if (n == 0)
+            return;
+        if (n == 1 || _workers.size() == 0 || _inside()) {
+            for (size_t i = 0; i < n; ++i)
+                f(i);
+            return;
+        }
+        std::lock_guard<std::mutex> run_lock(_run_mutex);
+        std::function<void(size_t)> job(std::ref(f));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = &job;
+            _count = n;
+            _next = 0;
+            _busy = _workers.size();
+            _error = nullptr;
+            ++_generation;
+        }
+        _wake.notify_all();
+        _work();
+        std::exception_ptr e;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _busy == 0; });
+            _job = nullptr;
+            e = _error;
+        }
+        if (e)
+            std::rethrow_exception(e);
+    }
+
+    //the pool used when none is given, with one thread per hardware thread
+    static thread_pool &global() {
+        static thread_pool pool;
+        return pool;
+    }
+
+private:
+    //whether this thread is running a job
+    static bool &_inside() {
+        static thread_local bool inside = false;
+        return inside;
+    }
+    void _work() {
+        _inside() = true;
+        for (size_t i; (i = _next.fetch_add(1)) < _count; ) {
+            try {
+                (*_job)(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error)
+                    _error = std::current_exception();
+            }
+        }
+        _inside() = false;
+    }
+    void _loop() {
+        size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stop || _generation != seen; });
+                if (_stop)
+                    return;
+                seen = _generation;
+            }
+            _work();
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busy == 0)
+                _done.notify_one();
+        }
+    }
+};
+
+/**
+ * parallel algorithms on a thread_pool, thread_pool::global() if none is given.
+ * the iterators must be over contiguous storage: those of sjtu::vector,
+ * small_vector and mmap_vector, or plain pointers.
+ * the work is cut into chunks of consecutive elements and each chunk runs as a plain loop,
+ * so the operations must be safe to call from several threads at once.
+ */
+namespace parallel {
+
+//below this many elements a chunk is not worth a thread
+constexpr size_t grain = 4096;
+
+template<class It>
+auto _addr(It it) -> decltype(&*it) {
+    return &*it;
+}
+
+//cut [0, n) into chunks for pool, chunk c being [_bound(n, k, c), _bound(n, k, c + 1))
+inline size_t _chunks(thread_pool &pool, size_t n) {
+    size_t k = (n + grain - 1) / grain;
+    return k < pool.size() * 4 ? k : pool.size() * 4;
+}
+inline size_t _bound(size_t n, size_t k, size_t c) {
+    return (size_t)((unsigned long long)n * c / k);
+}
+
+template<class It, class F>
+void for_each(thread_pool &pool, It first, It last, F f) {
+    size_t n = last - first;
+    if (n == 0)
+        return;
+    auto p = _addr(first);
+    size_t k = _chunks(pool, n);
+    pool.run(k, [&](size_t c) {
+        for (size_t i = _bound(n, k, c), e = _bound(n, k, c + 1); i < e; ++i)
+            f(p[i]);
+    });
+}
+template<class It, class F>
+void for_each(It first, It last, F f) {
+    for_each(thread_pool::global(), first, last, f);
+}
+
+//d_first[i] = op(first[i]), d_first may be first
+template<class It, class OutIt, class F>
+OutIt transform(thread_pool &pool, It first, It last, OutIt d_first, F op) {
+    size_t n = last - first;
+    if (n == 0)
+        return d_first;
+    auto p = _addr(first);
+    auto q = _addr(d_first);
+    size_t k = _chunks(pool, n);
+    pool.run(k, [&](size_t c) {
+        for (size_t i = _bound(n, k, c), e = _bound(n, k, c + 1); i < e; ++i)
+            q[i] = op(p[i]);
+    });
+    return d_first + n;
+}
+template<class It, class OutIt, class F>
+OutIt transform(It first, It last, OutIt d_first, F op) {
+    return transform(thread_pool::global(), first, last, d_first, op);
+}
+
+//init op first[0] op first[1] ..., op must be associative as the chunks are summed separately
+template<class It, class T, class Op = std::plus<T>>
+T reduce(thread_pool &pool, It first, It last, T init, Op op = Op()) {
+    size_t n = last - first;
+    if (n == 0)
+        return init;
+    auto p = _addr(first);
+    size_t k = _chunks(pool, n);
+    //a packed vector<bool> would share words between the threads writing it
+    vector<T, growth_double, _unpacked_allocator<T>> part(k, init);
+    pool.run(k, [&](size_t c) {
+        size_t i = _bound(n, k, c), e = _bound(n, k, c + 1);
+        T s = p[i];
+        for (++i; i < e; ++i)
+            s = op(s, p[i]);
+        part[c] = s;
+    });
+    for (size_t c = 0; c < k; ++c)
+        init = op(init, part[c]);
+    return init;
+}
+template<class It, class T, class Op = std::plus<T>>
+T reduce(It first, It last, T init, Op op = Op()) {
+    return reduce(thread_pool::global(), first, last, init, op);
+}
+
+//d_first[i] = first[0] op ... op first[i], d_first may be first
+//the chunks are summed first, then scanned again starting from the sum of those before them
+template<class It, class OutIt, class Op = std::plus<typename iterator_traits<It>::value_type>>
+OutIt inclusive_scan(thread_pool &pool, It first, It last, OutIt d_first, Op op = Op()) {
+    using T = typename iterator_traits<It>::value_type;
+    size_t n = last - first;
+    if (n == 0)
+        return d_first;
+    auto p = _addr(first);
+    auto q = _addr(d_first);
+    size_t k = _chunks(pool, n);
+    vector<T, growth_double, _unpacked_allocator<T>> part(k, p[0]);
+    pool.run(k - 1, [&](size_t c) {
+        size_t i = _bound(n, k, c), e = _bound(n, k, c + 1);
+        T s = p[i];
+        for (++i; i < e; ++i)
+            s = op(s, p[i]);
+        part[c] = s;
+    });
+    for (size_t c = 1; c < k; ++c)
+        part[c] = op(part[c - 1], part[c]);
+    pool.run(k, [&](size_t c) {
+        size_t i = _bound(n, k, c), e = _bound(n, k, c + 1);
+        T s = c == 0 ? p[i] : op(part[c - 1], p[i]);
+        q[i] = s;
+        for (++i; i < e; ++i) {
+            s = op(s, p[i]);
+            q[i] = s;
+        }
+    });
+    return d_first + n;
+}
+template<class It, class OutIt>
+OutIt inclusive_scan(It first, It last, OutIt d_first) {
+    return inclusive_scan(thread_pool::global(), first, last, d_first);
+}
+template<class It, class OutIt, class Op>
+OutIt inclusive_scan(It first, It last, OutIt d_first, Op op) {
+    return inclusive_scan(thread_pool::global(), first, last, d_first, op);
+}
+
+//the number of elements of a taken by the first k elements of the stable merge of a and b
+template<class T, class Compare>
+size_t _split(const T *a, size_t na, const T *b, size_t nb, size_t k, Compare &comp) {
+    size_t lo = k > nb ? k - nb : 0, hi = k < na ? k : na;
+    while (lo < hi) {
+        size_t i = (lo + hi) / 2, j = k - i;
+        if (i < na && j > 0 && !comp(b[j - 1], a[i]))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+/**
+ * sort [first, last) by comp, not stable.
+ * the chunks are sorted on their own, then merged pairwise round by round,
+ * each merge cut into pieces of the output by binary search so that all the threads take part.
+ * it needs a buffer of as many elements.
+ */
+template<class It, class Compare>
+void sort(thread_pool &pool, It first, It last, Compare comp) {
+    using T = typename iterator_traits<It>::value_type;
+    size_t n = last - first;
+    if (n == 0)
+        return;
+    T *p = _addr(first);
+    size_t k = _chunks(pool, n);
+    if (k <= 1) {
+        std::sort(p, p + n, comp);
+        return;
+    }
+    T *buf = (T *)malloc(sizeof(T) * n);
+    if (buf == nullptr)
+        throw std::bad_alloc();
+    //move the elements into the buffer and sort its chunks there
+    pool.run(k, [&](size_t c) {
+        size_t i = _bound(n, k, c), e = _bound(n, k, c + 1);
+        for (size_t j = i; j < e; ++j)
+            new (buf + j) T(std::move(p[j]));
+        std::sort(buf + i, buf + e, comp);
+    });
+    vector<size_t> bound;
+    for (size_t c = 0; c <= k; ++c)
+        bound.push_back(_bound(n, k, c));
+    T *src = buf, *dst = p;
+    while (bound.size() > 2) {
+        size_t pairs = (bound.size() - 1) / 2, odd = (bound.size() - 1) % 2;
+        size_t pieces = (pool.size() * 2 + pairs - 1) / pairs;
+        //the cuts are all found before any element is moved away
+        vector<size_t> cut(pairs * (pieces + 1), 0);
+        pool.run(pairs, [&](size_t pr) {
+            size_t lo = bound[pr * 2], mid = bound[pr * 2 + 1], hi = bound[pr * 2 + 2];
+            for (size_t pc = 0; pc <= pieces; ++pc)
+                cut[pr * (pieces + 1) + pc] = _split(src + lo, mid - lo, src + mid, hi - mid,
+                                                     _bound(hi - lo, pieces, pc), comp);
+        });
+        pool.run(pairs * pieces + odd, [&](size_t t) {
+            if (t == pairs * pieces) { //the last chunk has no partner
+                size_t i = bound[bound.size() - 2], e = bound.back();
+                std::move(src + i, src + e, dst + i);
+                return;
+            }
+            size_t pr = t / pieces, pc = t % pieces;
+            size_t lo = bound[pr * 2], mid = bound[pr * 2 + 1], hi = bound[pr * 2 + 2];
+            size_t k0 = _bound(hi - lo, pieces, pc), k1 = _bound(hi - lo, pieces, pc + 1);
+            size_t i0 = cut[pr * (pieces + 1) + pc], i1 = cut[pr * (pieces + 1) + pc + 1];
+            std::merge(std::make_move_iterator(src + lo + i0), std::make_move_iterator(src + lo + i1),
+                       std::make_move_iterator(src + mid + (k0 - i0)), std::make_move_iterator(src + mid + (k1 - i1)),
+                       dst + lo + k0, comp);
+        });
+        vector<size_t> next;
+        for (size_t c = 0; c < bound.size(); c += 2)
+            next.push_back(bound[c]);
+        if (next.back() != n)
+            next.push_back(n);
+        bound = std::move(next);
+        std::swap(src, dst);
+    }
+    size_t parts = _chunks(pool, n);
+    pool.run(parts, [&](size_t c) {
+        size_t i = _bound(n, parts, c), e = _bound(n, parts, c + 1);
+        if (src == buf)
+            std::move(buf + i, buf + e, p + i);
+        for (size_t j = i; j < e; ++j)
+            buf[j].~T();
+    });
+    free((void *)buf);
+}
+template<class It>
+void sort(thread_pool &pool, It first, It last) {
+    sort(pool, first, last, std::less<typename iterator_traits<It>::value_type>());
+}
+template<class It, class Compare>
+void sort(It first, It last, Compare comp) {
+    sort(thread_pool::global(), first, last, comp);
+}
+template<class It>
+void sort(It first, It last) {
+    sort(thread_pool::global(), first, last);
+}
+
+}
+
+}
+
+#endif
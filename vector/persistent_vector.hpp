@@ -0,0 +1,491 @@
+#ifndef SJTU_PERSISTENT_VECTOR_HPP
+#define SJTU_PERSISTENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * an immutable vector, every update returns a new version and leaves the old one as it was.
+ * the elements are kept in a trie of 32-way nodes with the last (up to) 32 elements
+ * in a separate tail, as in Clojure's vectors.
+ * a new version shares all the nodes but those on the path to the changed element,
+ * so push_back, set and pop_back copy O(log32 n) nodes, and at() reads O(log32 n) nodes.
+ * copying a version is O(1).
+ * the nodes are reference counted with atomic counters, so versions may be read
+ * and updated from different threads.
+ * an update called on an rvalue (e.g. v = std::move(v).push_back(x)) changes the nodes
+ * it owns alone in place.
+ * an update builds its new path before giving up the old nodes,
+ * so if it throws every version is left as it was.
+ */
+template<typename T>
+class persistent_vector {
+public:
+    using value_type        = T;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+private:
+    static constexpr size_t BITS = 5;
+    static constexpr size_t WIDTH = (size_t)1 << BITS;
+    static constexpr size_t MASK = WIDTH - 1;
+
+    struct _Node {
+        std::atomic<size_t> refs;
+        _Node() : refs(1) {}
+    };
+    struct _Branch : _Node {
+        _Node *child[WIDTH];
+        _Branch() {
+            for (size_t i = 0; i < WIDTH; ++i)
+                child[i] = nullptr;
+        }
+    };
+    struct _Leaf : _Node {
+        size_t len = 0;
+        alignas(T) unsigned char buf[sizeof(T) * WIDTH];
+        T *data() {
+            return (T *)buf;
+        }
+    };
+
+    size_t _size = 0;
+    size_t _shift = BITS; //level of the root, leaves are at level 0
+    _Branch *_root;
+    _Leaf *_tail;
+
+public:
+    persistent_vector() : _root(new _Branch()), _tail(new _Leaf()) {}
+    template<class InputIt>
+    persistent_vector(InputIt first, InputIt last) : persistent_vector() {
+        for (; first != last; ++first)
+            _push(*first);
+    }
+    persistent_vector(const persistent_vector &other) :
+        _size(other._size), _shift(other._shift), _root(_ref(other._root)), _tail(_ref(other._tail)) {}
+    //other is left empty, its nodes are made when it is pushed into again
+    persistent_vector(persistent_vector &&other) :
+        _size(other._size), _shift(other._shift), _root(other._root), _tail(other._tail) {
+        other._size = 0;
+        other._shift = BITS;
+        other._root = nullptr;
+        other._tail = nullptr;
+    }
+    ~persistent_vector() {
+        _release(_root, _shift);
+        _release(_tail, 0);
+    }
+    persistent_vector &operator =(persistent_vector other) {
+        swap(other);
+        return *this;
+    }
+    void swap(persistent_vector &other) {
+        std::swap(_size, other._size);
+        std::swap(_shift, other._shift);
+        std::swap(_root, other._root);
+        std::swap(_tail, other._tail);
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+    const T &at(const size_type &pos) const {
+        if (pos >= _size)
+            throw index_out_of_bound();
+        return _block(pos)[pos & MASK];
+    }
+    const T &operator [](const size_type &pos) const {
+        if (checked_access && pos >= _size)
+            throw index_out_of_bound();
+        return _block(pos)[pos & MASK];
+    }
+    const T &front() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return (*this)[0];
+    }
+    const T &back() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _tail->data()[_tail->len - 1];
+    }
+
+    //the version with value appended
+    persistent_vector push_back(const T &value) const & {
+        persistent_vector v(*this);
+        v._push(value);
+        return v;
+    }
+    persistent_vector push_back(const T &value) && {
+        persistent_vector v(std::move(*this));
+        v._push(value);
+        return v;
+    }
+    //the version with the pos-th element replaced by value
+    persistent_vector set(const size_type &pos, const T &value) const & {
+        persistent_vector v(*this);
+        v._set(pos, value);
+        return v;
+    }
+    persistent_vector set(const size_type &pos, const T &value) && {
+        persistent_vector v(std::move(*this));
+        v._set(pos, value);
+        return v;
+    }
+    //the version without the last element
+    persistent_vector pop_back() const & {
+        persistent_vector v(*this);
+        v._pop();
+        return v;
+    }
+    persistent_vector pop_back() && {
+        persistent_vector v(std::move(*this));
+        v._pop();
+        return v;
+    }
+
+    /**
+     * a forward iterator reading one block of 32 elements after another
+     */
+    class const_iterator {
+        friend class persistent_vector;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = const T *;
+        using reference         = const T &;
+    private:
+        const persistent_vector *_container = nullptr;
+        size_t _pos = 0;
+        const T *_cur = nullptr; //the block holding _pos
+
+        const_iterator(const persistent_vector *c, size_t pos) : _container(c), _pos(pos) {
+            if (pos < c->_size)
+                _cur = c->_block(pos);
+        }
+    public:
+        const_iterator() = default;
+        const T &operator *() const {
+            if (checked_access && _cur == nullptr)
+                throw invalid_iterator();
+            return _cur[_pos & MASK];
+        }
+        const T *operator ->() const {
+            return &**this;
+        }
+        const_iterator &operator ++() {
+            if (checked_access && (_container == nullptr || _pos >= _container->_size))
+                throw invalid_iterator();
+            ++_pos;
+            if ((_pos & MASK) == 0)
+                _cur = _pos < _container->_size ? _container->_block(_pos) : nullptr;
+            return *this;
+        }
+        const_iterator operator ++(int) {
+            const_iterator t = *this;
+            ++*this;
+            return t;
+        }
+        bool operator ==(const const_iterator &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        bool operator !=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, _size);
+    }
+
+private:
+    size_t _tail_offset() const {
+        return _size - _tail->len;
+    }
+    //the 32 elements block holding the pos-th element
+    const T *_block(size_t pos) const {
+        if (pos >= _tail_offset())
+            return _tail->data();
+        const _Node *node = _root;
+        for (size_t level = _shift; level > 0; level -= BITS)
+            node = ((const _Branch *)node)->child[(pos >> level) & MASK];
+        return ((_Leaf *)node)->data();
+    }
+
+    template<class N>
+    static N *_ref(N *node) {
+        if (node != nullptr)
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+    static void _release(_Node *node, size_t level) {
+        if (node == nullptr || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        if (level == 0) {
+            _Leaf *leaf = (_Leaf *)node;
+            for (size_t i = 0; i < leaf->len; ++i)
+                leaf->data()[i].~T();
+            delete leaf;
+        }
+        else {
+            _Branch *branch = (_Branch *)node;
+            for (size_t i = 0; i < WIDTH; ++i)
+                _release(branch->child[i], level - BITS);
+            delete branch;
+        }
+    }
+    static bool _unique(const _Node *node) {
+        return node->refs.load(std::memory_order_acquire) == 1;
+    }
+    //a copy of node sharing its children, node is left alone
+    static _Branch *_copy(const _Branch *node) {
+        _Branch *b = new _Branch();
+        for (size_t i = 0; i < WIDTH; ++i)
+            b->child[i] = _ref(node->child[i]);
+        return b;
+    }
+    static _Leaf *_copy(_Leaf *node) {
+        _Leaf *l = new _Leaf();
+        try {
+            for (; l->len < node->len; ++l->len)
+                new (l->data() + l->len) T(node->data()[l->len]);
+        }
+        catch (...) {
+            _release(l, 0);
+            throw;
+        }
+        return l;
+    }
+    //a leaf of our own in place of node, our reference to node is given up
+    static _Leaf *_own(_Leaf *node) {
+        if (_unique(node))
+            return node;
+        _Leaf *l = _copy(node);
+        _release(node, 0);
+        return l;
+    }
+
+    void _push(const T &value) {
+        if (_tail == nullptr) {
+            _Branch *r = new _Branch();
+            try {
+                _tail = new _Leaf();
+            }
+            catch (...) {
+                delete r;
+                throw;
+            }
+            _root = r;
+        }
+        if (_tail->len == WIDTH) {
+            //the new tail holds value before the full tail goes into the trie
+            _Leaf *t = new _Leaf();
+            try {
+                new (t->data()) T(value);
+                t->len = 1;
+                //a new level is added when the root is full
+                if ((_size >> BITS) > ((size_t)1 << _shift)) {
+                    _Branch *r = new _Branch();
+                    try {
+                        r->child[1] = _path(_shift, _tail);
+                    }
+                    catch (...) {
+                        delete r;
+                        throw;
+                    }
+                    r->child[0] = _root;
+                    _root = r;
+                    _shift += BITS;
+                }
+                else
+                    _root = _push_tail(_shift, _root, _tail);
+            }
+            catch (...) {
+                _release(t, 0);
+                throw;
+            }
+            _tail = t;
+            ++_size;
+            return;
+        }
+        _Leaf *t = _own(_tail);
+        _tail = t;
+        new (t->data() + t->len) T(value);
+        ++t->len;
+        ++_size;
+    }
+    //a chain of branches from level down to leaf
+    static _Node *_path(size_t level, _Leaf *leaf) {
+        if (level == 0)
+            return leaf;
+        _Branch *b = new _Branch();
+        try {
+            b->child[0] = _path(level - BITS, leaf);
+        }
+        catch (...) {
+            delete b;
+            throw;
+        }
+        return b;
+    }
+    //put c as the i-th child of b, a copy of node or node itself, and give up our reference to node
+    static _Branch *_commit(_Branch *b, _Branch *node, size_t level, size_t i, _Node *c) {
+        b->child[i] = c;
+        if (b != node)
+            _release(node, level);
+        return b;
+    }
+    //hang leaf, the block of the elements before _size, under node at level
+    //node and leaf are given up only if it succeeds
+    _Branch *_push_tail(size_t level, _Branch *node, _Leaf *leaf) {
+        size_t i = ((_size - 1) >> level) & MASK;
+        _Branch *b = _unique(node) ? node : _copy(node);
+        _Node *c;
+        try {
+            if (level == BITS)
+                c = leaf;
+            else if (b->child[i] != nullptr)
+                c = _push_tail(level - BITS, (_Branch *)b->child[i], leaf);
+            else
+                c = _path(level - BITS, leaf);
+        }
+        catch (...) {
+            if (b != node)
+                _release(b, level);
+            throw;
+        }
+        return _commit(b, node, level, i, c);
+    }
+
+    void _set(size_t pos, const T &value) {
+        if (pos >= _size)
+            throw index_out_of_bound();
+        T _tmp(value);
+        if (pos >= _tail_offset()) {
+            _tail = _own(_tail);
+            _tail->data()[pos & MASK] = std::move(_tmp);
+        }
+        else
+            _root = (_Branch *)_set(_shift, _root, pos, _tmp);
+    }
+    //node with the element replaced, node is given up only if it succeeds
+    static _Node *_set(size_t level, _Node *node, size_t pos, T &value) {
+        if (level == 0) {
+            _Leaf *l = _unique(node) ? (_Leaf *)node : _copy((_Leaf *)node);
+            try {
+                l->data()[pos & MASK] = std::move(value);
+            }
+            catch (...) {
+                if (l != node)
+                    _release(l, 0);
+                throw;
+            }
+            if (l != node)
+                _release(node, 0);
+            return l;
+        }
+        _Branch *b = _unique(node) ? (_Branch *)node : _copy((_Branch *)node);
+        size_t i = (pos >> level) & MASK;
+        _Node *c;
+        try {
+            c = _set(level - BITS, b->child[i], pos, value);
+        }
+        catch (...) {
+            if (b != node)
+                _release(b, level);
+            throw;
+        }
+        return _commit(b, (_Branch *)node, level, i, c);
+    }
+
+    void _pop() {
+        if (_size == 0)
+            throw container_is_empty();
+        if (_tail->len > 1 || _size == 1) {
+            _tail = _own(_tail);
+            --_tail->len;
+            _tail->data()[_tail->len].~T();
+            --_size;
+            return;
+        }
+        //the last block of the trie becomes the tail, and the trie is left empty
+        //when it was its only block
+        _Branch *r = _size - 1 == WIDTH ? new _Branch() : nullptr;
+        _Leaf *t = (_Leaf *)_ref(_leaf_of(_size - 2));
+        try {
+            _Branch *p = _pop_tail(_shift, _root);
+            if (p != nullptr) {
+                delete r;
+                r = p;
+            }
+        }
+        catch (...) {
+            _release(t, 0);
+            delete r;
+            throw;
+        }
+        _root = r;
+        _release(_tail, 0);
+        _tail = t;
+        if (_shift > BITS && _root->child[1] == nullptr) {
+            _Branch *r = (_Branch *)_ref(_root->child[0]);
+            _release(_root, _shift);
+            _root = r;
+            _shift -= BITS;
+        }
+        --_size;
+    }
+    _Node *_leaf_of(size_t pos) const {
+        _Node *node = _root;
+        for (size_t level = _shift; level > 0; level -= BITS)
+            node = ((_Branch *)node)->child[(pos >> level) & MASK];
+        return node;
+    }
+    //node at level without its last leaf, or nullptr if nothing is left
+    //node is given up only if it succeeds
+    _Branch *_pop_tail(size_t level, _Branch *node) {
+        size_t i = ((_size - 2) >> level) & MASK;
+        _Branch *c = nullptr;
+        if (level > BITS) {
+            _Branch *child = (_Branch *)_ref(node->child[i]);
+            try {
+                c = _pop_tail(level - BITS, child);
+            }
+            catch (...) {
+                _release(child, level - BITS);
+                throw;
+            }
+        }
+        if (c == nullptr && i == 0) {
+            _release(node, level);
+            return nullptr;
+        }
+        _Branch *b;
+        try {
+            b = _unique(node) ? node : _copy(node);
+        }
+        catch (...) {
+            _release(c, level - BITS);
+            throw;
+        }
+        _release(b->child[i], level - BITS);
+        return _commit(b, node, level, i, c);
+    }
+};
+
+}
+
+#endif
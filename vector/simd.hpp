@@ -0,0 +1,451 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * vectorized algorithms over vectors of integral and floating types:
+ *     find, count, min_element, max_element, accumulate, equal
+ * they scan data() directly instead of going through the checked iterators.
+ * kernels for AVX2 and SSE4.2 are built with gcc vector extensions
+ * and picked at runtime by what the cpu supports, with a plain loop as the fallback.
+ * define SJTU_NO_SIMD to always use the plain loop.
+ * vectors of other types get the plain loop as well,
+ * and a packed vector<bool> is scanned a word at a time.
+ */
+#if !defined(SJTU_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SJTU_SIMD_X86
+#endif
+
+namespace sjtu {
+
+namespace _simd {
+
+//types with vector kernels
+template <class T>
+struct vectorizable : std::integral_constant<bool,
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8> {};
+
+template <size_t Size> struct _uint;
+template <> struct _uint<1> { using type = uint8_t; };
+template <> struct _uint<2> { using type = uint16_t; };
+template <> struct _uint<4> { using type = uint32_t; };
+template <> struct _uint<8> { using type = uint64_t; };
+
+//plain loops, also used for the tails of the kernels
+struct _scalar {
+    template <class T>
+    static size_t find(const T *p, size_t n, T value) {
+        size_t i = 0;
+        while (i < n && !(p[i] == value))
+            ++i;
+        return i;
+    }
+    template <class T>
+    static size_t count(const T *p, size_t n, T value) {
+        size_t c = 0;
+        for (size_t i = 0; i < n; ++i)
+            c += p[i] == value;
+        return c;
+    }
+    template <class T>
+    static size_t min_element(const T *p, size_t n) {
+        size_t best = 0;
+        for (size_t i = 1; i < n; ++i)
+            if (p[i] < p[best])
+                best = i;
+        return best;
+    }
+    template <class T>
+    static size_t max_element(const T *p, size_t n) {
+        size_t best = 0;
+        for (size_t i = 1; i < n; ++i)
+            if (p[best] < p[i])
+                best = i;
+        return best;
+    }
+    template <class T, class U>
+    static U accumulate(const T *p, size_t n, U init) {
+        for (size_t i = 0; i < n; ++i)
+            init = init + p[i];
+        return init;
+    }
+    template <class T>
+    static bool equal(const T *a, const T *b, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            if (!(a[i] == b[i]))
+                return false;
+        return true;
+    }
+};
+
+#ifdef SJTU_SIMD_X86
+
+#define SJTU_SIMD_INLINE inline __attribute__((always_inline))
+
+//vectors never cross a call boundary as the kernels are always inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+//kernels working on W bytes at a time
+//they are inlined into the entries below, which are compiled for the instruction set of W
+template <class T, size_t W>
+struct _kernel {
+    typedef T _vec __attribute__((vector_size(W)));
+    using _U = typename _uint<sizeof(T)>::type;
+    typedef _U _mask __attribute__((vector_size(W)));
+    static constexpr size_t L = W / sizeof(T); //lanes
+
+    static SJTU_SIMD_INLINE _vec _load(const T *p) {
+        _vec x;
+        memcpy(&x, p, W);
+        return x;
+    }
+    static SJTU_SIMD_INLINE bool _any(const _mask &m) {
+        _U r = 0;
+        for (size_t j = 0; j < L; ++j)
+            r |= m[j];
+        return r != 0;
+    }
+
+    static SJTU_SIMD_INLINE size_t find(const T *p, size_t n, T value) {
+        const _vec s = _vec{} + value;
+        size_t i = 0;
+        for (; i + L <= n; i += L)
+            if (_any((_mask)(_load(p + i) == s)))
+                return i + _scalar::find(p + i, L, value);
+        return i + _scalar::find(p + i, n - i, value);
+    }
+    static SJTU_SIMD_INLINE size_t count(const T *p, size_t n, T value) {
+        //a lane counts up to its maximum before it is flushed
+        const size_t flush = sizeof(T) >= sizeof(size_t) ? (size_t)-1 : (size_t)(_U)-1;
+        const _vec s = _vec{} + value;
+        size_t c = 0, i = 0;
+        while (i + L <= n) {
+            _mask acc = _mask{};
+            for (size_t k = 0; k < flush && i + L <= n; ++k, i += L)
+                acc -= (_mask)(_load(p + i) == s);
+            for (size_t j = 0; j < L; ++j)
+                c += acc[j];
+        }
+        return c + _scalar::count(p + i, n - i, value);
+    }
+    //the smallest value, only comparable values (not NaN) are taken after p[0]
+    static SJTU_SIMD_INLINE T min(const T *p, size_t n) {
+        _vec m = _vec{} + p[0];
+        size_t i = 0;
+        for (; i + L <= n; i += L) {
+            _vec x = _load(p + i);
+            m = x < m ? x : m;
+        }
+        T r = p[0];
+        for (size_t j = 0; j < L; ++j)
+            if (m[j] < r)
+                r = m[j];
+        for (; i < n; ++i)
+            if (p[i] < r)
+                r = p[i];
+        return r;
+    }
+    static SJTU_SIMD_INLINE T max(const T *p, size_t n) {
+        _vec m = _vec{} + p[0];
+        size_t i = 0;
+        for (; i + L <= n; i += L) {
+            _vec x = _load(p + i);
+            m = m < x ? x : m;
+        }
+        T r = p[0];
+        for (size_t j = 0; j < L; ++j)
+            if (r < m[j])
+                r = m[j];
+        for (; i < n; ++i)
+            if (r < p[i])
+                r = p[i];
+        return r;
+    }
+    static SJTU_SIMD_INLINE size_t min_element(const T *p, size_t n) {
+        if (!(p[0] == p[0])) //NaN at the front compares false with everything
+            return 0;
+        return find(p, n, min(p, n));
+    }
+    static SJTU_SIMD_INLINE size_t max_element(const T *p, size_t n) {
+        if (!(p[0] == p[0]))
+            return 0;
+        return find(p, n, max(p, n));
+    }
+    static SJTU_SIMD_INLINE T accumulate(const T *p, size_t n, T init) {
+        //integers are added in unsigned lanes, which wrap instead of overflowing
+        using _lane = typename std::conditional<std::is_integral<T>::value, _U, T>::type;
+        typedef _lane _acc __attribute__((vector_size(W)));
+        _acc acc = _acc{};
+        size_t i = 0;
+        for (; i + L <= n; i += L)
+            acc += (_acc)_load(p + i);
+        for (size_t j = 0; j < L; ++j)
+            init = (T)(init + (T)acc[j]);
+        return _scalar::accumulate(p + i, n - i, init);
+    }
+    static SJTU_SIMD_INLINE bool equal(const T *a, const T *b, size_t n) {
+        size_t i = 0;
+        for (; i + L <= n; i += L)
+            if (_any(~(_mask)(_load(a + i) == _load(b + i))))
+                return false;
+        return _scalar::equal(a + i, b + i, n - i);
+    }
+};
+
+//0: plain loop, 1: SSE4.2, 2: AVX2
+inline int level() {
+    static const int _level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return 2;
+        if (__builtin_cpu_supports("sse4.2"))
+            return 1;
+        return 0;
+    }();
+    return _level;
+}
+
+#define SJTU_SIMD_ENTRY(R, name, params, args)                                      \
+    template <class T>                                                              \
+    __attribute__((target("avx2"))) R name##_avx2 params {                          \
+        return _kernel<T, 32>::name args;                                           \
+    }                                                                               \
+    template <class T>                                                              \
+    __attribute__((target("sse4.2"))) R name##_sse4 params {                        \
+        return _kernel<T, 16>::name args;                                           \
+    }                                                                               \
+    template <class T>                                                              \
+    R name params {                                                                 \
+        switch (level()) {                                                          \
+        case 2: return name##_avx2 args;                                            \
+        case 1: return name##_sse4 args;                                            \
+        default: return _scalar::name args;                                         \
+        }                                                                           \
+    }
+
+#pragma GCC diagnostic pop
+
+#else
+
+inline int level() {
+    return 0;
+}
+
+#define SJTU_SIMD_ENTRY(R, name, params, args)                                      \
+    template <class T>                                                              \
+    R name params {                                                                 \
+        return _scalar::name args;                                                  \
+    }
+
+#endif
+
+SJTU_SIMD_ENTRY(size_t, find, (const T *p, size_t n, T value), (p, n, value))
+SJTU_SIMD_ENTRY(size_t, count, (const T *p, size_t n, T value), (p, n, value))
+SJTU_SIMD_ENTRY(size_t, min_element, (const T *p, size_t n), (p, n))
+SJTU_SIMD_ENTRY(size_t, max_element, (const T *p, size_t n), (p, n))
+SJTU_SIMD_ENTRY(T, accumulate, (const T *p, size_t n, T init), (p, n, init))
+SJTU_SIMD_ENTRY(bool, equal, (const T *a, const T *b, size_t n), (a, b, n))
+
+#undef SJTU_SIMD_ENTRY
+#undef SJTU_SIMD_INLINE
+
+//the entries above for vectorizable types, the plain loops otherwise
+template <class T>
+size_t _find(const T *p, size_t n, const T &value, std::true_type) {
+    return find(p, n, value);
+}
+template <class T>
+size_t _find(const T *p, size_t n, const T &value, std::false_type) {
+    return _scalar::find(p, n, value);
+}
+template <class T>
+size_t _count(const T *p, size_t n, const T &value, std::true_type) {
+    return count(p, n, value);
+}
+template <class T>
+size_t _count(const T *p, size_t n, const T &value, std::false_type) {
+    return _scalar::count(p, n, value);
+}
+template <class T>
+size_t _min_element(const T *p, size_t n, std::true_type) {
+    return n == 0 ? 0 : min_element(p, n);
+}
+template <class T>
+size_t _min_element(const T *p, size_t n, std::false_type) {
+    return n == 0 ? 0 : _scalar::min_element(p, n);
+}
+template <class T>
+size_t _max_element(const T *p, size_t n, std::true_type) {
+    return n == 0 ? 0 : max_element(p, n);
+}
+template <class T>
+size_t _max_element(const T *p, size_t n, std::false_type) {
+    return n == 0 ? 0 : _scalar::max_element(p, n);
+}
+template <class T>
+bool _equal(const T *a, const T *b, size_t n, std::true_type) {
+    //integers are equal iff their bytes are
+    if (std::is_integral<T>::value)
+        return n == 0 || memcmp(a, b, sizeof(T) * n) == 0;
+    return equal(a, b, n);
+}
+template <class T>
+bool _equal(const T *a, const T *b, size_t n, std::false_type) {
+    return _scalar::equal(a, b, n);
+}
+
+//the index of the first bit equal to value among the n packed bits, or n
+inline size_t _find_bit(const uint64_t *p, size_t n, bool value) {
+    for (size_t i = 0; i * 64 < n; ++i) {
+        uint64_t w = value ? p[i] : ~p[i];
+        if (n - i * 64 < 64)
+            w &= ((uint64_t)1 << (n - i * 64)) - 1;
+        if (w != 0) {
+            size_t j = 0;
+            for (; (w & 1) == 0; w >>= 1)
+                ++j;
+            return i * 64 + j;
+        }
+    }
+    return n;
+}
+//init plus ones true values
+template <class U>
+U _add_ones(U init, size_t ones, std::true_type) {
+    return init + (U)ones;
+}
+template <class U>
+U _add_ones(U init, size_t ones, std::false_type) {
+    for (size_t i = 0; i < ones; ++i)
+        init = init + true;
+    return init;
+}
+
+}
+
+/**
+ * the first element equal to value, or end()
+ */
+template <class T, class Growth, class Alloc>
+typename vector<T, Growth, Alloc>::iterator find(vector<T, Growth, Alloc> &v, const T &value) {
+    size_t i = _simd::_find(v.data(), v.size(), value, _simd::vectorizable<T>());
+    return typename vector<T, Growth, Alloc>::iterator(v.data() + i, &v);
+}
+template <class T, class Growth, class Alloc>
+typename vector<T, Growth, Alloc>::const_iterator find(const vector<T, Growth, Alloc> &v, const T &value) {
+    size_t i = _simd::_find(v.data(), v.size(), value, _simd::vectorizable<T>());
+    return typename vector<T, Growth, Alloc>::const_iterator(const_cast<T *>(v.data()) + i, const_cast<vector<T, Growth, Alloc> *>(&v));
+}
+//a packed vector<bool> has no data(), its words are scanned instead
+template <class Growth>
+typename vector<bool, Growth, allocator<bool>>::iterator find(vector<bool, Growth, allocator<bool>> &v, const bool &value) {
+    return v.begin() + _simd::_find_bit(v.words(), v.size(), value);
+}
+template <class Growth>
+typename vector<bool, Growth, allocator<bool>>::const_iterator find(const vector<bool, Growth, allocator<bool>> &v, const bool &value) {
+    return v.cbegin() + _simd::_find_bit(v.words(), v.size(), value);
+}
+
+/**
+ * the number of elements equal to value
+ */
+template <class T, class Growth, class Alloc>
+size_t count(const vector<T, Growth, Alloc> &v, const T &value) {
+    return _simd::_count(v.data(), v.size(), value, _simd::vectorizable<T>());
+}
+//a packed vector<bool> counts its words by popcount
+template <class Growth>
+size_t count(const vector<bool, Growth, allocator<bool>> &v, const bool &value) {
+    return value ? v.count() : v.size() - v.count();
+}
+
+/**
+ * the first smallest (largest) element by operator <, or end() if v is empty
+ */
+template <class T, class Growth, class Alloc>
+typename vector<T, Growth, Alloc>::iterator min_element(vector<T, Growth, Alloc> &v) {
+    size_t i = _simd::_min_element((const T *)v.data(), v.size(), _simd::vectorizable<T>());
+    return typename vector<T, Growth, Alloc>::iterator(v.data() + i, &v);
+}
+template <class T, class Growth, class Alloc>
+typename vector<T, Growth, Alloc>::const_iterator min_element(const vector<T, Growth, Alloc> &v) {
+    size_t i = _simd::_min_element(v.data(), v.size(), _simd::vectorizable<T>());
+    return typename vector<T, Growth, Alloc>::const_iterator(const_cast<T *>(v.data()) + i, const_cast<vector<T, Growth, Alloc> *>(&v));
+}
+template <class T, class Growth, class Alloc>
+typename vector<T, Growth, Alloc>::iterator max_element(vector<T, Growth, Alloc> &v) {
+    size_t i = _simd::_max_element((const T *)v.data(), v.size(), _simd::vectorizable<T>());
+    return typename vector<T, Growth, Alloc>::iterator(v.data() + i, &v);
+}
+template <class T, class Growth, class Alloc>
+typename vector<T, Growth, Alloc>::const_iterator max_element(const vector<T, Growth, Alloc> &v) {
+    size_t i = _simd::_max_element(v.data(), v.size(), _simd::vectorizable<T>());
+    return typename vector<T, Growth, Alloc>::const_iterator(const_cast<T *>(v.data()) + i, const_cast<vector<T, Growth, Alloc> *>(&v));
+}
+//the first false (true) bit of a packed vector<bool>, or the first bit if they are all equal
+template <class Growth>
+typename vector<bool, Growth, allocator<bool>>::iterator min_element(vector<bool, Growth, allocator<bool>> &v) {
+    size_t i = _simd::_find_bit(v.words(), v.size(), false);
+    return v.begin() + (i == v.size() ? 0 : i);
+}
+template <class Growth>
+typename vector<bool, Growth, allocator<bool>>::const_iterator min_element(const vector<bool, Growth, allocator<bool>> &v) {
+    size_t i = _simd::_find_bit(v.words(), v.size(), false);
+    return v.cbegin() + (i == v.size() ? 0 : i);
+}
+template <class Growth>
+typename vector<bool, Growth, allocator<bool>>::iterator max_element(vector<bool, Growth, allocator<bool>> &v) {
+    size_t i = _simd::_find_bit(v.words(), v.size(), true);
+    return v.begin() + (i == v.size() ? 0 : i);
+}
+template <class Growth>
+typename vector<bool, Growth, allocator<bool>>::const_iterator max_element(const vector<bool, Growth, allocator<bool>> &v) {
+    size_t i = _simd::_find_bit(v.words(), v.size(), true);
+    return v.cbegin() + (i == v.size() ? 0 : i);
+}
+
+/**
+ * init plus all the elements
+ * the kernels only run when init has the type of the elements.
+ * they add the elements lane by lane, so a floating sum may round
+ * differently from a plain loop.
+ */
+template <class T, class Growth, class Alloc, class U>
+U accumulate(const vector<T, Growth, Alloc> &v, U init) {
+    return _simd::_scalar::accumulate(v.data(), v.size(), init);
+}
+template <class T, class Growth, class Alloc>
+typename std::enable_if<_simd::vectorizable<T>::value, T>::type
+accumulate(const vector<T, Growth, Alloc> &v, T init) {
+    return _simd::accumulate(v.data(), v.size(), init);
+}
+//a packed vector<bool> adds its number of ones
+template <class Growth, class U>
+U accumulate(const vector<bool, Growth, allocator<bool>> &v, U init) {
+    return _simd::_add_ones(init, v.count(), std::is_arithmetic<U>());
+}
+
+/**
+ * whether a and b have the same elements, compared by operator ==
+ */
+template <class T, class Growth1, class Alloc1, class Growth2, class Alloc2>
+bool equal(const vector<T, Growth1, Alloc1> &a, const vector<T, Growth2, Alloc2> &b) {
+    return a.size() == b.size() && _simd::_equal(a.data(), b.data(), a.size(), _simd::vectorizable<T>());
+}
+//packed vector<bool>s compare their words, the bits past size() are always zero
+template <class Growth1, class Growth2>
+bool equal(const vector<bool, Growth1, allocator<bool>> &a, const vector<bool, Growth2, allocator<bool>> &b) {
+    return a.size() == b.size()
+        && (a.word_count() == 0 || memcmp(a.words(), b.words(), sizeof(uint64_t) * a.word_count()) == 0);
+}
+
+}
+
+#endif
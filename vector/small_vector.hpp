@@ -0,0 +1,187 @@
+#ifndef SJTU_SMALL_VECTOR_HPP
+#define SJTU_SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+
+namespace sjtu {
+
+/**
+ * an allocator owning an inline buffer of N elements.
+ * the buffer is handed out to one block of at most N elements at a time,
+ * larger blocks come from the heap.
+ * a copy of it gets its own buffer, so it must not be shared between containers.
+ */
+template<class T, size_t N>
+class inline_allocator {
+public:
+    using value_type    = T;
+    using pointer       = T *;
+    using size_type     = size_t;
+
+    template<class U>
+    struct rebind {
+        using other = inline_allocator<U, N>;
+    };
+
+private:
+    alignas(T) unsigned char _buf[sizeof(T) * N];
+    bool _used = false;
+
+    //a heap block of n elements, failing with bad_alloc rather than nullptr
+    static T *_malloc(size_type n) {
+        if (n > (size_type)-1 / sizeof(T))
+            throw std::bad_alloc();
+        T *p = (T *)malloc(sizeof(T) * n);
+        if (p == nullptr && n != 0)
+            throw std::bad_alloc();
+        return p;
+    }
+
+public:
+    inline_allocator() {}
+    inline_allocator(const inline_allocator &) {}
+    inline_allocator &operator =(const inline_allocator &) {
+        return *this;
+    }
+
+    bool is_inline(const T *p) const {
+        return p == (const T *)_buf;
+    }
+
+    T *allocate(size_type n) {
+        if (n <= N && !_used) {
+            _used = true;
+            return (T *)_buf;
+        }
+        return _malloc(n);
+    }
+    void deallocate(T *p, size_type n) {
+        (void)n;
+        if (is_inline(p))
+            _used = false;
+        else
+            free((void *)p);
+    }
+    //blocks move between the buffer and the heap when they cross N
+    T *reallocate(T *p, size_type n, size_type cap) {
+        if (p == nullptr)
+            return allocate(cap);
+        if (is_inline(p)) {
+            if (cap <= N)
+                return p;
+            T *q = _malloc(cap);
+            memcpy((void *)q, (void *)p, sizeof(T) * n);
+            _used = false;
+            return q;
+        }
+        if (cap <= N && !_used) {
+            memcpy((void *)_buf, (void *)p, sizeof(T) * (n < cap ? n : cap));
+            free((void *)p);
+            _used = true;
+            return (T *)_buf;
+        }
+        if (cap > (size_type)-1 / sizeof(T))
+            throw std::bad_alloc();
+        T *q = (T *)realloc((void *)p, sizeof(T) * cap);
+        //the block p is left as it was
+        if (q == nullptr && cap != 0)
+            throw std::bad_alloc();
+        return q;
+    }
+
+    //only the same object can free the inline buffer it handed out
+    bool operator ==(const inline_allocator &other) const {
+        return this == &other;
+    }
+    bool operator !=(const inline_allocator &other) const {
+        return this != &other;
+    }
+};
+
+/**
+ * a vector keeping up to N elements inside the object itself.
+ * it only allocates when it grows past N elements.
+ * the interface and the iterators are those of sjtu::vector.
+ */
+template<typename T, size_t N, class Growth = growth_double>
+class small_vector : public vector<T, Growth, inline_allocator<T, N>> {
+    static_assert(N > 0, "use sjtu::vector for no inline elements");
+    using _base = vector<T, Growth, inline_allocator<T, N>>;
+
+public:
+    using typename _base::size_type;
+    using typename _base::iterator;
+    using typename _base::const_iterator;
+
+    small_vector() {
+        this->_reallocate(N);
+    }
+    small_vector(size_type n, const T &value) : small_vector() {
+        this->assign(n, value);
+    }
+    template<class InputIt, class = typename _base::template _if_iterator<InputIt>>
+    small_vector(InputIt first, InputIt last) : small_vector() {
+        this->assign(first, last);
+    }
+    small_vector(const small_vector &other) : small_vector() {
+        this->assign(other.cbegin(), other.cend());
+    }
+    small_vector(small_vector &&other) : small_vector() {
+        _take(other);
+    }
+
+    small_vector &operator =(const small_vector &other) {
+        if (this != &other)
+            this->assign(other.cbegin(), other.cend());
+        return *this;
+    }
+    small_vector &operator =(small_vector &&other) {
+        if (this != &other)
+            _take(other);
+        return *this;
+    }
+
+    //whether the elements are stored inside the object
+    bool is_inline() const {
+        return this->_alloc.is_inline(this->data());
+    }
+
+    //the inline buffer is kept after clear()
+    void clear() {
+        _base::clear();
+        this->_reallocate(N);
+    }
+    //move the elements back into the object if they fit
+    void shrink_to_fit() {
+        if (is_inline())
+            return;
+        if (this->size() <= N)
+            this->_reallocate(N);
+        else
+            _base::shrink_to_fit();
+    }
+
+protected:
+    //take the elements of other, leaving it empty
+    //a heap buffer is taken as a whole, inline elements are moved one by one
+    void _take(small_vector &other) {
+        if (other.is_inline()) {
+            this->assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        else {
+            this->_steal(other);
+            other._reallocate(N);
+        }
+    }
+};
+
+}
+
+#endif
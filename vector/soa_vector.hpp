@@ -0,0 +1,417 @@
+#ifndef SJTU_SOA_VECTOR_HPP
+#define SJTU_SOA_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a vector of records whose fields are kept in separate arrays, one sjtu::vector per field.
+ * a loop reading two fields of every record only pulls those two arrays through the cache,
+ * data<I>() hands out the array of the I-th field for such loops.
+ *
+ * the records are std::tuple<Ts...> when they are copied in or out;
+ * operator [] and the iterators give a proxy reference instead of a real one,
+ * whose get<I>() refers to the field in its array.
+ * assigning to a proxy assigns the fields, and swap() on two proxies swaps the records.
+ *
+ * push_back, insert and emplace_back leave the vector as it was if a field throws.
+ */
+template<class... Ts>
+class soa_vector {
+    static_assert(sizeof...(Ts) > 0, "a record needs at least one field");
+
+public:
+    using value_type        = std::tuple<Ts...>;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    template<size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+
+private:
+    static constexpr size_t FIELDS = sizeof...(Ts);
+    using _indices = std::make_index_sequence<FIELDS>;
+
+    std::tuple<vector<Ts, growth_double, _unpacked_allocator<Ts>>...> _fields;
+
+public:
+    /**
+     * a reference to the record at some index, R is Ts... or const Ts...
+     * it refers to the fields, not to the vector, so it stays valid until they are reallocated
+     */
+    template<class... R>
+    class _reference {
+        friend class soa_vector;
+        template<class... R2>
+        friend class _reference;
+
+        mutable std::tuple<R &...> _refs;
+        explicit _reference(R &...refs) : _refs(refs...) {}
+
+    public:
+        _reference(const _reference &) = default;
+        //a mutable reference converts to a const one
+        template<class... R2, class = typename std::enable_if<!std::is_same<std::tuple<R2...>, std::tuple<R...>>::value>::type>
+        _reference(const _reference<R2...> &other) : _refs(other._refs) {}
+
+        template<size_t I>
+        typename std::tuple_element<I, std::tuple<R &...>>::type get() const {
+            return std::get<I>(_refs);
+        }
+        //a copy of the record
+        operator value_type() const {
+            return value_type(_refs);
+        }
+
+        //these assign the fields of the record
+        const _reference &operator =(const value_type &value) const {
+            _refs = value;
+            return *this;
+        }
+        const _reference &operator =(value_type &&value) const {
+            _refs = std::move(value);
+            return *this;
+        }
+        const _reference &operator =(const _reference &other) const {
+            _refs = other._refs;
+            return *this;
+        }
+        template<class... R2>
+        const _reference &operator =(const _reference<R2...> &other) const {
+            _refs = other._refs;
+            return *this;
+        }
+
+        bool operator ==(const value_type &value) const {
+            return _refs == value;
+        }
+        bool operator !=(const value_type &value) const {
+            return !(*this == value);
+        }
+
+        friend void swap(const _reference &a, const _reference &b) {
+            a._swap(b, _indices());
+        }
+
+    private:
+        template<size_t... I>
+        void _swap(const _reference &other, std::index_sequence<I...>) const {
+            using std::swap;
+            int _[] = {0, (swap(std::get<I>(_refs), std::get<I>(other._refs)), 0)...};
+            (void)_;
+        }
+    };
+    using reference         = _reference<Ts...>;
+    using const_reference   = _reference<const Ts...>;
+
+    /**
+     * a random access iterator over the records, C is soa_vector or const soa_vector
+     */
+    template<class C, class Ref>
+    class _iterator {
+        friend class soa_vector;
+        template<class C2, class Ref2>
+        friend class _iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = typename soa_vector::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = void;
+        using reference         = Ref;
+    private:
+        C *_container = nullptr;
+        size_t _pos = 0;
+        _iterator(C *c, size_t pos) : _container(c), _pos(pos) {}
+    public:
+        _iterator() = default;
+        //an iterator converts to a const_iterator
+        template<class C2, class Ref2, class = typename std::enable_if<std::is_convertible<C2 *, C *>::value>::type>
+        _iterator(const _iterator<C2, Ref2> &other) : _container(other._container), _pos(other._pos) {}
+
+        Ref operator *() const {
+            if (checked_access && (_container == nullptr || _pos >= _container->size()))
+                throw invalid_iterator();
+            return _container->_at(_pos);
+        }
+        Ref operator [](const difference_type &n) const {
+            return *(*this + n);
+        }
+        _iterator operator +(const difference_type &n) const {
+            return _iterator(_container, _pos + n);
+        }
+        _iterator operator -(const difference_type &n) const {
+            return _iterator(_container, _pos - n);
+        }
+        template<class C2, class Ref2>
+        difference_type operator -(const _iterator<C2, Ref2> &rhs) const {
+            if (checked_access && _container != rhs._container)
+                throw invalid_iterator();
+            return (difference_type)_pos - (difference_type)rhs._pos;
+        }
+        _iterator &operator +=(const difference_type &n) {
+            _pos += n;
+            return *this;
+        }
+        _iterator &operator -=(const difference_type &n) {
+            _pos -= n;
+            return *this;
+        }
+        _iterator &operator ++() {
+            ++_pos;
+            return *this;
+        }
+        _iterator operator ++(int) {
+            _iterator t = *this;
+            ++_pos;
+            return t;
+        }
+        _iterator &operator --() {
+            --_pos;
+            return *this;
+        }
+        _iterator operator --(int) {
+            _iterator t = *this;
+            --_pos;
+            return t;
+        }
+        template<class C2, class Ref2>
+        bool operator ==(const _iterator<C2, Ref2> &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        template<class C2, class Ref2>
+        bool operator !=(const _iterator<C2, Ref2> &rhs) const {
+            return !(*this == rhs);
+        }
+        template<class C2, class Ref2>
+        bool operator <(const _iterator<C2, Ref2> &rhs) const {
+            return _pos < rhs._pos;
+        }
+    };
+    using iterator          = _iterator<soa_vector, reference>;
+    using const_iterator    = _iterator<const soa_vector, const_reference>;
+
+    soa_vector() {}
+    soa_vector(size_type n, const value_type &value) {
+        assign(n, value);
+    }
+    soa_vector(const soa_vector &) = default;
+    soa_vector(soa_vector &&) = default;
+    soa_vector &operator =(const soa_vector &) = default;
+    soa_vector &operator =(soa_vector &&) = default;
+
+    //the array of the I-th field, size() elements long
+    template<size_t I>
+    field_type<I> *data() {
+        return std::get<I>(_fields).data();
+    }
+    template<size_t I>
+    const field_type<I> *data() const {
+        return std::get<I>(_fields).data();
+    }
+
+    reference at(const size_type &pos) {
+        if (pos >= size())
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    const_reference at(const size_type &pos) const {
+        if (pos >= size())
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    reference operator [](const size_type &pos) {
+        if (checked_access && pos >= size())
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    const_reference operator [](const size_type &pos) const {
+        if (checked_access && pos >= size())
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    const_reference front() const {
+        if (empty())
+            throw container_is_empty();
+        return _at(0);
+    }
+    const_reference back() const {
+        if (empty())
+            throw container_is_empty();
+        return _at(size() - 1);
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, size());
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, size());
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+    size_type size() const {
+        return std::get<0>(_fields).size();
+    }
+    //the number of records every field has room for
+    size_type capacity() const {
+        return _capacity(_indices());
+    }
+    void clear() {
+        _each(_indices(), [](auto &f) { f.clear(); });
+    }
+    void reserve(size_type n) {
+        _each(_indices(), [n](auto &f) { f.reserve(n); });
+    }
+    void shrink_to_fit() {
+        _each(_indices(), [](auto &f) { f.shrink_to_fit(); });
+    }
+    //resize to n records, new fields are value-initialized
+    void resize(size_type n) {
+        reserve(n);
+        _each(_indices(), [n](auto &f) { f.resize(n); });
+    }
+    void assign(size_type n, const value_type &value) {
+        clear();
+        reserve(n);
+        while (size() < n)
+            push_back(value);
+    }
+
+    //append a record made of one argument per field
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == FIELDS, "one argument per field");
+        insert(size(), std::forward<Args>(args)...);
+    }
+    void push_back(const value_type &value) {
+        _insert(size(), value, _indices());
+    }
+    void push_back(value_type &&value) {
+        _insert(size(), std::move(value), _indices());
+    }
+    void pop_back() {
+        if (empty())
+            throw container_is_empty();
+        _each(_indices(), [](auto &f) { f.pop_back(); });
+    }
+
+    //insert a record made of one argument per field in front of the ind-th one
+    template<class... Args>
+    iterator insert(const size_type &ind, Args&&... args) {
+        static_assert(sizeof...(Args) == FIELDS, "one argument per field");
+        return _insert(ind, std::forward_as_tuple(std::forward<Args>(args)...), _indices());
+    }
+    iterator insert(const size_type &ind, const value_type &value) {
+        return _insert(ind, value, _indices());
+    }
+    iterator insert(const size_type &ind, value_type &&value) {
+        return _insert(ind, std::move(value), _indices());
+    }
+    iterator insert(iterator pos, const value_type &value) {
+        return insert(_index(pos), value);
+    }
+    iterator insert(iterator pos, value_type &&value) {
+        return insert(_index(pos), std::move(value));
+    }
+
+    iterator erase(const size_type &ind) {
+        if (ind >= size())
+            throw index_out_of_bound();
+        _each(_indices(), [ind](auto &f) { f.erase(ind); });
+        return iterator(this, ind);
+    }
+    iterator erase(iterator pos) {
+        return erase(_index(pos));
+    }
+    //erase [first, last)
+    iterator erase(iterator first, iterator last) {
+        if (checked_access && (first._container != this || last._container != this || last._pos < first._pos
+                               || last._pos > size()))
+            throw invalid_iterator();
+        size_type b = first._pos, e = last._pos;
+        _each(_indices(), [b, e](auto &f) { f.erase(f.begin() + b, f.begin() + e); });
+        return iterator(this, b);
+    }
+
+private:
+    reference _at(size_t pos) {
+        return _at(pos, _indices());
+    }
+    const_reference _at(size_t pos) const {
+        return _at(pos, _indices());
+    }
+    template<size_t... I>
+    reference _at(size_t pos, std::index_sequence<I...>) {
+        return reference(std::get<I>(_fields).data()[pos]...);
+    }
+    template<size_t... I>
+    const_reference _at(size_t pos, std::index_sequence<I...>) const {
+        return const_reference(std::get<I>(_fields).data()[pos]...);
+    }
+
+    size_type _index(const iterator &pos) const {
+        if (checked_access && pos._container != this)
+            throw invalid_iterator();
+        return pos._pos;
+    }
+
+    //call f on every field
+    template<class F, size_t... I>
+    void _each(std::index_sequence<I...>, F f) {
+        int _[] = {0, (f(std::get<I>(_fields)), 0)...};
+        (void)_;
+    }
+    template<size_t... I>
+    size_type _capacity(std::index_sequence<I...>) const {
+        size_type cap[] = {std::get<I>(_fields).capacity()...};
+        size_type n = cap[0];
+        for (size_t i = 1; i < FIELDS; ++i)
+            if (cap[i] < n)
+                n = cap[i];
+        return n;
+    }
+
+    //every field is grown before any is touched, so the inserts below do not reallocate
+    //and a throwing field only has to take back the fields inserted before it
+    template<class Tuple, size_t... I>
+    iterator _insert(size_type ind, Tuple &&values, std::index_sequence<I...>) {
+        if (ind > size())
+            throw index_out_of_bound();
+        if (size() == capacity())
+            reserve(growth_double::next(size()));
+        _insert_field(ind, std::forward<Tuple>(values), std::integral_constant<size_t, 0>());
+        return iterator(this, ind);
+    }
+    template<class Tuple, size_t I>
+    void _insert_field(size_type ind, Tuple &&values, std::integral_constant<size_t, I>) {
+        auto &f = std::get<I>(_fields);
+        f.insert(ind, std::get<I>(std::forward<Tuple>(values)));
+        try {
+            _insert_field(ind, std::forward<Tuple>(values), std::integral_constant<size_t, I + 1>());
+        }
+        catch (...) {
+            f.erase(ind);
+            throw;
+        }
+    }
+    template<class Tuple>
+    void _insert_field(size_type, Tuple &&, std::integral_constant<size_t, FIELDS>) {}
+};
+
+}
+
+#endif
@@ -0,0 +1,532 @@
+#ifndef SJTU_SORT_HPP
+#define SJTU_SORT_HPP
+
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * sorting a vector in place:
+ *     sort, stable_sort, sort_by_key, nth_element
+ * they work on data() directly instead of going through the checked iterators.
+ * vectors of integral and floating types, and of pairs of them, are sorted by an LSD
+ * radix sort, one pass per byte of the key, and so is sort_by_key() whenever the key
+ * function gives such a type. a pass is skipped when all the keys share that byte.
+ * the rest is sorted by pdqsort (pattern-defeating quicksort), which is O(n log n)
+ * in the worst case and linear on sorted, reversed and all-equal input.
+ * the radix sorts leave -0.0 and 0.0 in input order, NaNs go after +inf (or before -inf
+ * if their sign bit is set).
+ */
+
+namespace sjtu {
+
+namespace _sort {
+
+/**
+ * the keys a radix sort handles: encode() gives an unsigned code of bytes bytes,
+ * ordered as the keys themselves, and byte(code, i) its i-th least significant byte
+ */
+template <class K, class = void>
+struct radix_traits : std::false_type {};
+
+//the codes of integral and floating keys are unsigned integers of the same size
+template <class U>
+struct _uint_traits : std::true_type {
+    using code_type = U;
+    static constexpr size_t bytes = sizeof(U);
+    static unsigned byte(U c, size_t i) {
+        return (unsigned)(c >> (8 * i)) & 255;
+    }
+    static bool less(U a, U b) {
+        return a < b;
+    }
+};
+
+template <class K>
+struct radix_traits<K, typename std::enable_if<std::is_integral<K>::value>::type>
+    : _uint_traits<typename std::make_unsigned<typename std::conditional<std::is_same<K, bool>::value, char, K>::type>::type> {
+    using _U = typename std::make_unsigned<typename std::conditional<std::is_same<K, bool>::value, char, K>::type>::type;
+    //flipping the sign bit orders the signed values as unsigned ones
+    static _U encode(K k) {
+        return std::is_signed<K>::value ? (_U)((_U)k ^ (_U)((_U)1 << (8 * sizeof(_U) - 1))) : (_U)k;
+    }
+};
+
+template <class K>
+struct radix_traits<K, typename std::enable_if<std::is_floating_point<K>::value && (sizeof(K) == 4 || sizeof(K) == 8)>::type>
+    : _uint_traits<typename std::conditional<sizeof(K) == 4, uint32_t, uint64_t>::type> {
+    using _U = typename std::conditional<sizeof(K) == 4, uint32_t, uint64_t>::type;
+    //negative values have all their bits flipped, the others only the sign bit
+    static _U encode(K k) {
+        k += K(0); //-0.0 becomes 0.0
+        _U x;
+        memcpy(&x, &k, sizeof(x));
+        const _U sign = (_U)1 << (8 * sizeof(_U) - 1);
+        return x & sign ? ~x : x | sign;
+    }
+};
+
+//pairs are ordered by first, then by second; the bytes of second are the less significant ones
+template <class P, class A, class B>
+struct _pair_traits : std::integral_constant<bool, radix_traits<A>::value && radix_traits<B>::value> {
+    using _RA = radix_traits<A>;
+    using _RB = radix_traits<B>;
+    struct code_type {
+        typename _RA::code_type first;
+        typename _RB::code_type second;
+    };
+    static constexpr size_t bytes = _RA::bytes + _RB::bytes;
+    static code_type encode(const P &k) {
+        return code_type{_RA::encode(k.first), _RB::encode(k.second)};
+    }
+    static unsigned byte(const code_type &c, size_t i) {
+        return i < _RB::bytes ? _RB::byte(c.second, i) : _RA::byte(c.first, i - _RB::bytes);
+    }
+    static bool less(const code_type &a, const code_type &b) {
+        if (_RA::less(a.first, b.first))
+            return true;
+        if (_RA::less(b.first, a.first))
+            return false;
+        return _RB::less(a.second, b.second);
+    }
+};
+template <class A, class B>
+struct radix_traits<pair<A, B>> : _pair_traits<pair<A, B>, A, B> {};
+template <class A, class B>
+struct radix_traits<std::pair<A, B>> : _pair_traits<std::pair<A, B>, A, B> {};
+
+//the elements a radix pass may move into raw memory and back without destroying them
+template <class T>
+struct _movable : std::integral_constant<bool,
+    std::is_nothrow_move_constructible<T>::value && std::is_trivially_destructible<T>::value> {};
+
+template <class T>
+struct _identity {
+    const T &operator ()(const T &x) const {
+        return x;
+    }
+};
+
+//below this many elements a radix sort is not worth its passes
+constexpr size_t _radix_threshold = 256;
+constexpr size_t _insertion_threshold = 24;
+constexpr size_t _ninther_threshold = 128;
+constexpr size_t _partial_insertion_limit = 8;
+
+template <class T, class Compare>
+void _insertion_sort(T *begin, T *end, Compare comp) {
+    if (begin == end)
+        return;
+    for (T *cur = begin + 1; cur != end; ++cur) {
+        T *sift = cur, *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+//the same when an element no greater than all of them lies before begin
+template <class T, class Compare>
+void _unguarded_insertion_sort(T *begin, T *end, Compare comp) {
+    if (begin == end)
+        return;
+    for (T *cur = begin + 1; cur != end; ++cur) {
+        T *sift = cur, *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+//an insertion sort that gives up after a few moves, return whether it sorted the range
+template <class T, class Compare>
+bool _partial_insertion_sort(T *begin, T *end, Compare comp) {
+    if (begin == end)
+        return true;
+    size_t moves = 0;
+    for (T *cur = begin + 1; cur != end; ++cur) {
+        T *sift = cur, *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            moves += cur - sift;
+        }
+        if (moves > _partial_insertion_limit)
+            return false;
+    }
+    return true;
+}
+
+template <class T, class Compare>
+void _sort2(T *a, T *b, Compare comp) {
+    if (comp(*b, *a))
+        std::iter_swap(a, b);
+}
+template <class T, class Compare>
+void _sort3(T *a, T *b, T *c, Compare comp) {
+    _sort2(a, b, comp);
+    _sort2(b, c, comp);
+    _sort2(a, b, comp);
+}
+
+//move the median of 3 (or of 3 medians of 3 for large ranges) to *begin
+template <class T, class Compare>
+void _choose_pivot(T *begin, T *end, Compare comp) {
+    size_t n = end - begin, s2 = n / 2;
+    if (n > _ninther_threshold) {
+        _sort3(begin, begin + s2, end - 1, comp);
+        _sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+        _sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+        _sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+        std::iter_swap(begin, begin + s2);
+    }
+    else
+        _sort3(begin + s2, begin, end - 1, comp);
+}
+
+/**
+ * partition around the pivot *begin: the elements less than it go to its left.
+ * return where the pivot ends up, and whether no element had to be swapped.
+ * the pivot must be a median taken from the range, so that the scans stop inside it.
+ */
+template <class T, class Compare>
+std::pair<T *, bool> _partition_right(T *begin, T *end, Compare comp) {
+    T pivot(std::move(*begin));
+    T *first = begin, *last = end;
+    while (comp(*++first, pivot));
+    if (first - 1 == begin)
+        while (first < last && !comp(*--last, pivot));
+    else
+        while (!comp(*--last, pivot));
+    bool partitioned = first >= last;
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(*++first, pivot));
+        while (!comp(*--last, pivot));
+    }
+    T *pos = first - 1;
+    *begin = std::move(*pos);
+    *pos = std::move(pivot);
+    return std::pair<T *, bool>(pos, partitioned);
+}
+//the elements equal to the pivot go to its left, used when the pivot equals the element before the range
+template <class T, class Compare>
+T *_partition_left(T *begin, T *end, Compare comp) {
+    T pivot(std::move(*begin));
+    T *first = begin, *last = end;
+    while (comp(pivot, *--last));
+    if (last + 1 == end)
+        while (first < last && !comp(pivot, *++first));
+    else
+        while (!comp(pivot, *++first));
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(pivot, *--last));
+        while (!comp(pivot, *++first));
+    }
+    T *pos = last;
+    *begin = std::move(*pos);
+    *pos = std::move(pivot);
+    return pos;
+}
+
+//break up the patterns that made a partition unbalanced
+template <class T>
+void _shuffle(T *begin, T *pos, T *end) {
+    size_t l = pos - begin, r = end - (pos + 1);
+    if (l >= _insertion_threshold) {
+        std::iter_swap(begin, begin + l / 4);
+        std::iter_swap(pos - 1, pos - l / 4);
+        if (l > _ninther_threshold) {
+            std::iter_swap(begin + 1, begin + (l / 4 + 1));
+            std::iter_swap(begin + 2, begin + (l / 4 + 2));
+            std::iter_swap(pos - 2, pos - (l / 4 + 1));
+            std::iter_swap(pos - 3, pos - (l / 4 + 2));
+        }
+    }
+    if (r >= _insertion_threshold) {
+        std::iter_swap(pos + 1, pos + (1 + r / 4));
+        std::iter_swap(end - 1, end - r / 4);
+        if (r > _ninther_threshold) {
+            std::iter_swap(pos + 2, pos + (2 + r / 4));
+            std::iter_swap(pos + 3, pos + (3 + r / 4));
+            std::iter_swap(end - 2, end - (1 + r / 4));
+            std::iter_swap(end - 3, end - (2 + r / 4));
+        }
+    }
+}
+
+template <class T, class Compare>
+void _heap_sort(T *begin, T *end, Compare comp) {
+    std::make_heap(begin, end, comp);
+    std::sort_heap(begin, end, comp);
+}
+
+//bad is how many more unbalanced partitions are allowed before switching to heap sort
+template <class T, class Compare>
+void _pdqsort(T *begin, T *end, Compare comp, int bad, bool leftmost) {
+    while (true) {
+        size_t n = end - begin;
+        if (n < _insertion_threshold) {
+            if (leftmost)
+                _insertion_sort(begin, end, comp);
+            else
+                _unguarded_insertion_sort(begin, end, comp);
+            return;
+        }
+        _choose_pivot(begin, end, comp);
+        //many equal elements: put those equal to the pivot aside, they are in place already
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = _partition_left(begin, end, comp) + 1;
+            continue;
+        }
+        std::pair<T *, bool> part = _partition_right(begin, end, comp);
+        T *pos = part.first;
+        size_t l = pos - begin, r = end - (pos + 1);
+        if (l < n / 8 || r < n / 8) {
+            if (--bad == 0) {
+                _heap_sort(begin, end, comp);
+                return;
+            }
+            _shuffle(begin, pos, end);
+        }
+        //nothing moved, the range may be sorted already
+        else if (part.second && _partial_insertion_sort(begin, pos, comp) && _partial_insertion_sort(pos + 1, end, comp))
+            return;
+        _pdqsort(begin, pos, comp, bad, leftmost);
+        begin = pos + 1;
+        leftmost = false;
+    }
+}
+
+inline int _log2(size_t n) {
+    int r = 0;
+    while (n >>= 1)
+        ++r;
+    return r;
+}
+
+template <class T, class Compare>
+void pdqsort(T *begin, T *end, Compare comp) {
+    if (end - begin > 1)
+        _pdqsort(begin, end, comp, _log2(end - begin) + 1, true);
+}
+
+//introselect: partition as pdqsort does, but only go on into the side holding nth
+template <class T, class Compare>
+void select(T *begin, T *nth, T *end, Compare comp) {
+    int bad = _log2(end - begin) + 1;
+    while ((size_t)(end - begin) >= _insertion_threshold) {
+        _choose_pivot(begin, end, comp);
+        T *pos = _partition_right(begin, end, comp).first;
+        size_t n = end - begin, l = pos - begin, r = end - (pos + 1);
+        if (l < n / 8 || r < n / 8) {
+            if (--bad == 0) {
+                _heap_sort(begin, end, comp);
+                return;
+            }
+            _shuffle(begin, pos, end);
+        }
+        if (pos == nth)
+            return;
+        if (nth < pos)
+            end = pos;
+        else
+            begin = pos + 1;
+    }
+    _insertion_sort(begin, end, comp);
+}
+
+//compares the keys as a radix sort orders them, or by operator < if it cannot
+template <class K, bool = radix_traits<K>::value>
+struct _less {
+    static bool less(const K &a, const K &b) {
+        return radix_traits<K>::less(radix_traits<K>::encode(a), radix_traits<K>::encode(b));
+    }
+};
+template <class K>
+struct _less<K, false> {
+    static bool less(const K &a, const K &b) {
+        return a < b;
+    }
+};
+template <class Key>
+struct _key_less {
+    Key key;
+    template <class T>
+    bool operator ()(const T &a, const T &b) const {
+        using K = typename std::decay<decltype(key(a))>::type;
+        return _less<K>::less(key(a), key(b));
+    }
+};
+
+/**
+ * a stable LSD radix sort of [p, p + n) by key, a byte per pass.
+ * the elements are moved between p and a buffer of n, so they must be _movable.
+ */
+template <class T, class Key>
+void radix_sort(T *p, size_t n, Key key) {
+    using K = typename std::decay<decltype(key(*p))>::type;
+    using R = radix_traits<K>;
+    if (n < _radix_threshold) {
+        _insertion_sort(p, p + n, _key_less<Key>{key});
+        return;
+    }
+    //the counts of every byte of the keys, all from one read of the elements
+    vector<size_t> count(R::bytes * 256, 0);
+    size_t *c = count.data();
+    for (size_t i = 0; i < n; ++i) {
+        typename R::code_type k = R::encode(key(p[i]));
+        for (size_t b = 0; b < R::bytes; ++b)
+            ++c[b * 256 + R::byte(k, b)];
+    }
+    T *buf = (T *)malloc(sizeof(T) * n);
+    if (buf == nullptr)
+        throw std::bad_alloc();
+    T *src = p, *dst = buf;
+    size_t offset[256];
+    for (size_t b = 0; b < R::bytes; ++b) {
+        const size_t *cb = c + b * 256;
+        if (cb[R::byte(R::encode(key(p[0])), b)] == n)
+            continue;
+        for (size_t d = 0, s = 0; d < 256; ++d) {
+            offset[d] = s;
+            s += cb[d];
+        }
+        for (size_t i = 0; i < n; ++i)
+            new (dst + offset[R::byte(R::encode(key(src[i])), b)]++) T(std::move(src[i]));
+        std::swap(src, dst);
+    }
+    if (src != p)
+        for (size_t i = 0; i < n; ++i)
+            new (p + i) T(std::move(src[i]));
+    free(buf);
+}
+
+template <class T, class Key>
+void _sort_by_key(T *p, size_t n, Key key, std::true_type) {
+    radix_sort(p, n, key);
+}
+template <class T, class Key>
+void _sort_by_key(T *p, size_t n, Key key, std::false_type) {
+    std::stable_sort(p, p + n, _key_less<Key>{key});
+}
+
+template <class T, class Key>
+struct _radix_sortable : std::integral_constant<bool,
+    radix_traits<typename std::decay<decltype(std::declval<Key &>()(std::declval<const T &>()))>::type>::value
+    && _movable<T>::value> {};
+
+template <class T>
+void _sort(T *p, size_t n, std::true_type) {
+    radix_sort(p, n, _identity<T>());
+}
+template <class T>
+void _sort(T *p, size_t n, std::false_type) {
+    pdqsort(p, p + n, std::less<T>());
+}
+template <class T>
+void _stable_sort(T *p, size_t n, std::true_type) {
+    radix_sort(p, n, _identity<T>());
+}
+template <class T>
+void _stable_sort(T *p, size_t n, std::false_type) {
+    std::stable_sort(p, p + n, std::less<T>());
+}
+
+}
+
+/**
+ * sort v by operator <, not stable: by radix if T is an integral or floating type
+ * or a pair of them, by pdqsort otherwise
+ */
+template <class T, class Growth, class Alloc>
+void sort(vector<T, Growth, Alloc> &v) {
+    _sort::_sort(v.data(), v.size(), _sort::_radix_sortable<T, _sort::_identity<T>>());
+}
+//sort v by comp by pdqsort, not stable
+template <class T, class Growth, class Alloc, class Compare>
+void sort(vector<T, Growth, Alloc> &v, Compare comp) {
+    _sort::pdqsort(v.data(), v.data() + v.size(), comp);
+}
+
+/**
+ * sort v by operator <, equal elements keep their order: by radix as sort() does,
+ * by a merge sort otherwise
+ */
+template <class T, class Growth, class Alloc>
+void stable_sort(vector<T, Growth, Alloc> &v) {
+    _sort::_stable_sort(v.data(), v.size(), _sort::_radix_sortable<T, _sort::_identity<T>>());
+}
+template <class T, class Growth, class Alloc, class Compare>
+void stable_sort(vector<T, Growth, Alloc> &v, Compare comp) {
+    std::stable_sort(v.data(), v.data() + v.size(), comp);
+}
+
+/**
+ * sort v by key(element), stable.
+ * if key gives an integral or floating type, or a pair of them, this is a radix sort,
+ * which needs T to be nothrow move constructible and trivially destructible;
+ * otherwise the keys are compared by a merge sort.
+ * key is called a few times per element and per pass, so it should be cheap.
+ */
+template <class T, class Growth, class Alloc, class Key>
+void sort_by_key(vector<T, Growth, Alloc> &v, Key key) {
+    _sort::_sort_by_key(v.data(), v.size(), key, _sort::_radix_sortable<T, Key>());
+}
+
+/**
+ * rearrange v so that v[n] is the element a sort would put there,
+ * with no greater elements before it and no less ones after it.
+ * expected O(n), O(n log n) in the worst case.
+ * throw index_out_of_bound if n >= size()
+ */
+template <class T, class Growth, class Alloc, class Compare>
+void nth_element(vector<T, Growth, Alloc> &v, size_t n, Compare comp) {
+    if (n >= v.size())
+        throw index_out_of_bound();
+    _sort::select(v.data(), v.data() + n, v.data() + v.size(), comp);
+}
+template <class T, class Growth, class Alloc>
+void nth_element(vector<T, Growth, Alloc> &v, size_t n) {
+    nth_element(v, n, std::less<T>());
+}
+
+//a packed vector<bool> only counts its ones
+template <class Growth>
+void sort(vector<bool, Growth, allocator<bool>> &v) {
+    size_t n = v.size(), ones = v.count();
+    v.assign(n - ones, false);
+    v.resize(n, true);
+}
+template <class Growth>
+void stable_sort(vector<bool, Growth, allocator<bool>> &v) {
+    sort(v);
+}
+template <class Growth>
+void nth_element(vector<bool, Growth, allocator<bool>> &v, size_t n) {
+    if (n >= v.size())
+        throw index_out_of_bound();
+    sort(v);
+}
+
+}
+
+#endif
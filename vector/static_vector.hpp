@@ -0,0 +1,401 @@
+#ifndef SJTU_STATIC_VECTOR_HPP
+#define SJTU_STATIC_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * the elements of a static_vector.
+ * trivial types are kept in a plain array, so that everything can be constexpr;
+ * the others are constructed in raw bytes and destroyed by hand.
+ */
+template<class T, size_t N, bool = std::is_trivial<T>::value>
+class _static_storage {
+protected:
+    T _data[N > 0 ? N : 1] = {};
+    size_t _size = 0;
+
+    constexpr T *_begin() {
+        return _data;
+    }
+    constexpr const T *_begin() const {
+        return _data;
+    }
+    template<class... Args>
+    constexpr void _construct(size_t i, Args&&... args) {
+        _data[i] = T(std::forward<Args>(args)...);
+    }
+    constexpr void _destroy(size_t) {}
+};
+
+template<class T, size_t N>
+class _static_storage<T, N, false> {
+protected:
+    alignas(T) unsigned char _buf[sizeof(T) * (N > 0 ? N : 1)];
+    size_t _size = 0;
+
+    T *_begin() {
+        return (T *)_buf;
+    }
+    const T *_begin() const {
+        return (const T *)_buf;
+    }
+    template<class... Args>
+    void _construct(size_t i, Args&&... args) {
+        new (_begin() + i) T(std::forward<Args>(args)...);
+    }
+    void _destroy(size_t i) {
+        (_begin() + i)->~T();
+    }
+    void _clear() {
+        while (_size > 0)
+            _destroy(--_size);
+    }
+
+public:
+    _static_storage() {}
+    _static_storage(const _static_storage &other) {
+        for (; _size < other._size; ++_size)
+            _construct(_size, other._begin()[_size]);
+    }
+    _static_storage(_static_storage &&other) {
+        for (; _size < other._size; ++_size)
+            _construct(_size, std::move(other._begin()[_size]));
+    }
+    ~_static_storage() {
+        _clear();
+    }
+    _static_storage &operator =(const _static_storage &other) {
+        if (this == &other)
+            return *this;
+        _clear();
+        for (; _size < other._size; ++_size)
+            _construct(_size, other._begin()[_size]);
+        return *this;
+    }
+    _static_storage &operator =(_static_storage &&other) {
+        if (this == &other)
+            return *this;
+        _clear();
+        for (; _size < other._size; ++_size)
+            _construct(_size, std::move(other._begin()[_size]));
+        return *this;
+    }
+};
+
+/**
+ * a vector of at most N elements, kept inside the object itself, which never allocates.
+ * growing past N throws index_out_of_bound, the rest behaves as sjtu::vector.
+ * for trivial T every member is constexpr, so a static_vector can be filled and read
+ * at compile time, and it is trivially copyable.
+ */
+template<typename T, size_t N>
+class static_vector : public _static_storage<T, N> {
+    using _base = _static_storage<T, N>;
+    using _base::_size;
+    using _base::_begin;
+    using _base::_construct;
+    using _base::_destroy;
+
+    template<class InputIt>
+    using _if_iterator = typename std::enable_if<!std::is_integral<InputIt>::value>::type;
+
+public:
+    using value_type        = T;
+    using pointer           = T *;
+    using reference         = T &;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    /**
+     * a random access iterator, V is T or const T
+     */
+    template<class V, class C>
+    class _iterator {
+        friend class static_vector;
+        template<class V2, class C2>
+        friend class _iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = V *;
+        using reference         = V &;
+    private:
+        V *_ptr = nullptr;
+#ifndef SJTU_UNCHECKED
+        C *_container = nullptr;
+        constexpr C *_owner() const {
+            return _container;
+        }
+    public:
+        constexpr _iterator(V *p = nullptr, C *c = nullptr) : _ptr(p), _container(c) {}
+#else
+        constexpr C *_owner() const {
+            return nullptr;
+        }
+    public:
+        constexpr _iterator(V *p = nullptr, C * = nullptr) : _ptr(p) {}
+#endif
+        //an iterator converts to a const_iterator
+        template<class V2, class C2, class = typename std::enable_if<std::is_convertible<V2 *, V *>::value>::type>
+        constexpr _iterator(const _iterator<V2, C2> &other) : _iterator(other._ptr, other._owner()) {}
+
+        constexpr _iterator operator +(const difference_type &n) const {
+            return _iterator(_ptr + n, _owner());
+        }
+        constexpr _iterator operator -(const difference_type &n) const {
+            return _iterator(_ptr - n, _owner());
+        }
+        template<class V2, class C2>
+        constexpr difference_type operator -(const _iterator<V2, C2> &rhs) const {
+            if (checked_access && _owner() != rhs._owner())
+                throw invalid_iterator();
+            return _ptr - rhs._ptr;
+        }
+        constexpr _iterator &operator +=(const difference_type &n) {
+            _ptr += n;
+            return *this;
+        }
+        constexpr _iterator &operator -=(const difference_type &n) {
+            _ptr -= n;
+            return *this;
+        }
+        constexpr _iterator &operator ++() {
+            ++_ptr;
+            return *this;
+        }
+        constexpr _iterator operator ++(int) {
+            _iterator t = *this;
+            ++_ptr;
+            return t;
+        }
+        constexpr _iterator &operator --() {
+            --_ptr;
+            return *this;
+        }
+        constexpr _iterator operator --(int) {
+            _iterator t = *this;
+            --_ptr;
+            return t;
+        }
+        constexpr V &operator *() const {
+            return *_ptr;
+        }
+        constexpr V *operator ->() const {
+            return _ptr;
+        }
+        template<class V2, class C2>
+        constexpr bool operator ==(const _iterator<V2, C2> &rhs) const {
+            return _ptr == rhs._ptr;
+        }
+        template<class V2, class C2>
+        constexpr bool operator !=(const _iterator<V2, C2> &rhs) const {
+            return _ptr != rhs._ptr;
+        }
+    };
+    using iterator          = _iterator<T, static_vector>;
+    using const_iterator    = _iterator<const T, const static_vector>;
+
+    constexpr static_vector() {}
+    constexpr static_vector(size_type n, const T &value) {
+        assign(n, value);
+    }
+    constexpr static_vector(std::initializer_list<T> list) {
+        assign(list.begin(), list.end());
+    }
+    template<class InputIt, class = _if_iterator<InputIt>>
+    constexpr static_vector(InputIt first, InputIt last) {
+        assign(first, last);
+    }
+
+    constexpr T &at(const size_type &pos) {
+        if (pos >= _size)
+            throw index_out_of_bound();
+        return _begin()[pos];
+    }
+    constexpr const T &at(const size_type &pos) const {
+        if (pos >= _size)
+            throw index_out_of_bound();
+        return _begin()[pos];
+    }
+    constexpr T &operator [](const size_type &pos) {
+        if (checked_access && pos >= _size)
+            throw index_out_of_bound();
+        return _begin()[pos];
+    }
+    constexpr const T &operator [](const size_type &pos) const {
+        if (checked_access && pos >= _size)
+            throw index_out_of_bound();
+        return _begin()[pos];
+    }
+    constexpr const T &front() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _begin()[0];
+    }
+    constexpr const T &back() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _begin()[_size - 1];
+    }
+    constexpr T *data() {
+        return _begin();
+    }
+    constexpr const T *data() const {
+        return _begin();
+    }
+    constexpr iterator begin() {
+        return iterator(_begin(), this);
+    }
+    constexpr const_iterator cbegin() const {
+        return const_iterator(_begin(), this);
+    }
+    constexpr iterator end() {
+        return iterator(_begin() + _size, this);
+    }
+    constexpr const_iterator cend() const {
+        return const_iterator(_begin() + _size, this);
+    }
+    constexpr bool empty() const {
+        return _size == 0;
+    }
+    constexpr bool full() const {
+        return _size == N;
+    }
+    constexpr size_type size() const {
+        return _size;
+    }
+    static constexpr size_type capacity() {
+        return N;
+    }
+    constexpr void clear() {
+        _truncate(0);
+    }
+
+    //resize to n elements, new elements are value-initialized
+    //throw index_out_of_bound if n > N
+    constexpr void resize(size_type n) {
+        if (n > N)
+            throw index_out_of_bound();
+        for (; _size < n; ++_size)
+            _construct(_size);
+        _truncate(n);
+    }
+    constexpr void resize(size_type n, const T &value) {
+        if (n > N)
+            throw index_out_of_bound();
+        for (; _size < n; ++_size)
+            _construct(_size, value);
+        _truncate(n);
+    }
+    constexpr void assign(size_type n, const T &value) {
+        if (n > N)
+            throw index_out_of_bound();
+        T _tmp(value);
+        clear();
+        resize(n, _tmp);
+    }
+    template<class InputIt, class = _if_iterator<InputIt>>
+    constexpr void assign(InputIt first, InputIt last) {
+        clear();
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    //throw index_out_of_bound if the vector is full
+    template<class... Args>
+    constexpr void emplace_back(Args&&... args) {
+        if (_size == N)
+            throw index_out_of_bound();
+        _construct(_size, std::forward<Args>(args)...);
+        ++_size;
+    }
+    constexpr void push_back(const T &value) {
+        emplace_back(value);
+    }
+    constexpr void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+    constexpr void pop_back() {
+        if (_size == 0)
+            throw container_is_empty();
+        _destroy(--_size);
+    }
+
+    //construct the new element in front of pos
+    //throw index_out_of_bound if the vector is full
+    template<class... Args>
+    constexpr iterator emplace(iterator pos, Args&&... args) {
+        if (checked_access && pos._owner() != this)
+            throw invalid_iterator();
+        size_type ind = pos._ptr - _begin();
+        if (_size == N)
+            throw index_out_of_bound();
+        T _tmp(std::forward<Args>(args)...);
+        T *p = _begin();
+        if (ind == _size)
+            _construct(_size, std::move(_tmp));
+        else {
+            _construct(_size, std::move(p[_size - 1]));
+            for (size_type i = _size - 1; i > ind; --i)
+                p[i] = std::move(p[i - 1]);
+            p[ind] = std::move(_tmp);
+        }
+        ++_size;
+        return pos;
+    }
+    constexpr iterator insert(iterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+    constexpr iterator insert(iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+    constexpr iterator insert(const size_type &ind, const T &value) {
+        if (ind > _size)
+            throw index_out_of_bound();
+        return emplace(begin() + ind, value);
+    }
+    constexpr iterator insert(const size_type &ind, T &&value) {
+        if (ind > _size)
+            throw index_out_of_bound();
+        return emplace(begin() + ind, std::move(value));
+    }
+    constexpr iterator erase(iterator pos) {
+        return erase(pos, pos + 1);
+    }
+    //erase [first, last)
+    constexpr iterator erase(iterator first, iterator last) {
+        if (checked_access && (first._owner() != this || last._owner() != this || last - first < 0))
+            throw invalid_iterator();
+        size_type b = first._ptr - _begin(), n = last - first;
+        T *p = _begin();
+        for (size_type i = b; i + n < _size; ++i)
+            p[i] = std::move(p[i + n]);
+        _truncate(_size - n);
+        return first;
+    }
+    constexpr iterator erase(const size_type &ind) {
+        if (ind >= _size)
+            throw index_out_of_bound();
+        return erase(begin() + ind);
+    }
+
+private:
+    constexpr void _truncate(size_type n) {
+        while (_size > n)
+            _destroy(--_size);
+    }
+};
+
+}
+
+#endif
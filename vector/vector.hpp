@@ -2,10 +2,17 @@
 #define SJTU_VECTOR_HPP
 
 #include "exceptions.hpp"
+#include "allocator.hpp"
+#include "serialize.hpp"
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu {
 
@@ -34,11 +41,62 @@ struct iterator_traits<const T*>{
     using reference         = T &;
 };
 
+/**
+ * whether a T can be moved to another address by copying its bytes
+ * and then forgetting the original, without calling any constructor or destructor.
+ * it holds for trivially copyable types;
+ * specialize it as std::true_type for your own types which also hold it,
+ * e.g. most types owning a heap pointer.
+ */
+template <class T>
+struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+/**
+ * growth policies of vector
+ * next(cap) returns the capacity to grow to when a vector with capacity cap is full.
+ * it must be greater than cap.
+ */
+template <size_t Num, size_t Den>
+struct growth_factor{
+    static_assert(Num > Den && Den > 0, "the growth factor must be greater than 1");
+    static size_t next(size_t cap){
+        size_t _n = cap / Den * Num + cap % Den * Num / Den;
+        return _n > cap ? _n : cap + 1;
+    }
+};
+using growth_double         = growth_factor<2, 1>;
+using growth_one_and_half   = growth_factor<3, 2>;
+template <size_t N>
+struct growth_chunk{
+    static_assert(N > 0, "the growth chunk must not be empty");
+    static size_t next(size_t cap){
+        return cap + N;
+    }
+};
+
+//allocator<T> under another name, a vector<bool> using it is not packed
+//and hands out real bool references
+template<class T>
+struct _unpacked_allocator : allocator<T> {
+    template<class U>
+    struct rebind {
+        using other = _unpacked_allocator<U>;
+    };
+    _unpacked_allocator() = default;
+    template<class U>
+    _unpacked_allocator(const allocator<U> &) {}
+};
+//Alloc, but the allocator<bool> that packs a vector<bool> becomes _unpacked_allocator<bool>
+template<class Alloc>
+using _unpacked_t = typename std::conditional<std::is_same<Alloc, allocator<bool>>::value, _unpacked_allocator<bool>, Alloc>::type;
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * Growth decides how the capacity grows when pushing into a full vector.
+ * Alloc provides the storage, see allocator.hpp.
  */
-template<typename T>
+template<typename T, class Growth = growth_double, class Alloc = allocator<T>>
 class vector{
 public:
     using value_type        = T;
@@ -47,6 +105,13 @@ public:
     using size_type         = size_t;
     using difference_type   = ptrdiff_t;
 
+protected:
+    //keep (n, value) overloads from matching the iterator range ones
+    template<class InputIt>
+    using _if_iterator = typename std::enable_if<!std::is_integral<InputIt>::value>::type;
+    //holds a copy of a range while inserting, on the heap because Alloc may be tied to this vector
+    using _buffer = vector<T, Growth, _unpacked_allocator<T>>;
+
 public:
     class iterator;
     class const_iterator;
@@ -54,6 +119,25 @@ public:
     friend class const_iterator;
 protected:
     iterator start, finish, end_of_storage;
+    Alloc _alloc;
+
+public:
+    /**
+     * what the vector has done to its elements, counted only if SJTU_STATS is defined.
+     * elements relocated by memcpy, memmove or realloc only count as bytes moved,
+     * the others count as a copy or a move each, depending on which constructor or assignment was used.
+     * the elements put in or taken out by the caller are not counted.
+     */
+    struct stats_type{
+        size_t reallocations = 0;
+        size_t bytes_moved = 0;
+        size_t copies = 0;
+        size_t moves = 0;
+    };
+protected:
+#ifdef SJTU_STATS
+    stats_type _stats;
+#endif
 
 public:
 	class const_iterator;
@@ -68,35 +152,47 @@ public:
         using reference         = T &;
 	private:
 		T *_ptr;
+#ifndef SJTU_UNCHECKED
 	    vector *_container;
+	    vector *_owner() const {
+            return _container;
+	    }
 	public:
         iterator(T *_p = nullptr, vector *_c = nullptr) : _ptr(_p), _container(_c){}
-        iterator(const iterator &i) : _ptr(i._ptr), _container(i._container) {}
-        iterator(const const_iterator &ci) : _ptr(ci._ptr), _container(ci._container) {}
+#else
+	    vector *_owner() const {
+            return nullptr;
+	    }
+	public:
+        iterator(T *_p = nullptr, vector * = nullptr) : _ptr(_p) {}
+#endif
+        iterator(const iterator &) = default;
+        iterator(const const_iterator &i) : iterator(i._ptr, i._owner()) {}
+        iterator &operator =(const iterator &) = default;
 
 		iterator operator +(const int &n) const {
-		    return iterator(_ptr + n, _container);
+		    return iterator(_ptr + n, _owner());
 		}
 		iterator operator -(const int &n) const {
-			return iterator(_ptr - n, _container);
+			return iterator(_ptr - n, _owner());
 		}
 		difference_type operator -(const iterator &rhs) const {
-            if (_container != rhs._container)
+            if (checked_access && _owner() != rhs._owner())
                 throw invalid_iterator();
             return _ptr - rhs._ptr;
 		}
 		iterator operator +=(const int &n) {
 			_ptr += n;
-			return iterator(_ptr, _container);
+			return iterator(_ptr, _owner());
 		}
 		iterator operator -=(const int &n) {
 			_ptr -= n;
-			return iterator(_ptr, _container);
+			return iterator(_ptr, _owner());
 		}
 		iterator operator ++(int){
             T *_p = _ptr;
             ++_ptr;
-            return iterator(_p, _container);
+            return iterator(_p, _owner());
 		}
 		iterator &operator ++(){
 		    ++_ptr;
@@ -105,7 +201,7 @@ public:
 		iterator operator --(int){
             T *_p = _ptr;
             --_ptr;
-            return iterator(_p, _container);
+            return iterator(_p, _owner());
 		}
 		iterator& operator --(){
 		    --_ptr;
@@ -140,35 +236,47 @@ public:
         using reference         = T &;
 	private:
 		T *_ptr;
+#ifndef SJTU_UNCHECKED
 	    vector *_container;
+	    vector *_owner() const {
+            return _container;
+	    }
 	public:
         const_iterator(T *_p = nullptr, vector *_c = nullptr) : _ptr(_p), _container(_c){}
-        const_iterator(const iterator &i) : _ptr(i._ptr), _container(i._container) {}
-        const_iterator(const const_iterator &ci) : _ptr(ci._ptr), _container(ci._container) {}
+#else
+	    vector *_owner() const {
+            return nullptr;
+	    }
+	public:
+        const_iterator(T *_p = nullptr, vector * = nullptr) : _ptr(_p) {}
+#endif
+        const_iterator(const const_iterator &) = default;
+        const_iterator(const iterator &i) : const_iterator(i._ptr, i._owner()) {}
+        const_iterator &operator =(const const_iterator &) = default;
 
 		const_iterator operator +(const int &n) const {
-		    return const_iterator(_ptr + n, _container);
+		    return const_iterator(_ptr + n, _owner());
 		}
 		const_iterator operator -(const int &n) const {
-			return const_iterator(_ptr - n, _container);
+			return const_iterator(_ptr - n, _owner());
 		}
 		difference_type operator -(const const_iterator &rhs) const {
-            if (_container != rhs._container)
+            if (checked_access && _owner() != rhs._owner())
                 throw invalid_iterator();
-            return _ptr - rhs._ptr;;
+            return _ptr - rhs._ptr;
 		}
 		const_iterator operator +=(const int &n) {
 			_ptr += n;
-			return const_iterator(_ptr, _container);
+			return const_iterator(_ptr, _owner());
 		}
 		const_iterator operator -=(const int &n) {
 			_ptr -= n;
-			return const_iterator(_ptr, _container);
+			return const_iterator(_ptr, _owner());
 		}
 		const_iterator operator ++(int){
             T *_p = _ptr;
             ++_ptr;
-            return const_iterator(_p, _container);
+            return const_iterator(_p, _owner());
 		}
 		const_iterator &operator ++(){
 		    ++_ptr;
@@ -177,7 +285,7 @@ public:
 		const_iterator operator --(int){
             T *_p = _ptr;
             --_ptr;
-            return const_iterator(_p, _container);
+            return const_iterator(_p, _owner());
 		}
 		const_iterator& operator --(){
 		    --_ptr;
@@ -202,34 +310,46 @@ public:
     //end of class const_iterator
 
 	vector() : start(nullptr, this), finish(nullptr, this), end_of_storage(nullptr, this) {}
-	vector(const vector &other) {
-        start._container = this;
-        finish._container = this;
-        end_of_storage._container = this;
-        start._ptr = (T *) malloc(sizeof(T) * other.capacity());
-        finish._ptr = start._ptr + other.size();
-        end_of_storage._ptr = start._ptr + other.capacity();
-        for (size_type i = 0; i < other.size(); ++i)
-            *(start._ptr + i) = *(other.start._ptr + i);
+	explicit vector(const Alloc &alloc) :
+	    start(nullptr, this), finish(nullptr, this), end_of_storage(nullptr, this), _alloc(alloc) {}
+	vector(const vector &other) :
+	    start(nullptr, this), finish(nullptr, this), end_of_storage(nullptr, this), _alloc(other._alloc) {
+        assign(other.start._ptr, other.finish._ptr);
+	}
+	vector(size_type n, const T &value, const Alloc &alloc = Alloc()) : vector(alloc) {
+        _reset_storage(n);
+        _fill_back(n, value);
+	}
+	template<class InputIt, class = _if_iterator<InputIt>>
+	vector(InputIt first, InputIt last, const Alloc &alloc = Alloc()) : vector(alloc) {
+        assign(first, last);
+	}
+	//steal the buffer of other, leaving it empty
+	vector(vector &&other) noexcept :
+	    start(other.start._ptr, this), finish(other.finish._ptr, this), end_of_storage(other.end_of_storage._ptr, this),
+	    _alloc(std::move(other._alloc)) {
+        other.start._ptr = other.finish._ptr = other.end_of_storage._ptr = nullptr;
 	}
 	~vector() {
-        for (iterator _it = start; _it != finish; ++_it)
-            _it._ptr->~T();
-        free(start._ptr);
-        start._ptr = finish._ptr = end_of_storage._ptr = nullptr;
+        clear();
 	}
 	vector &operator =(const vector &other) {
-        if (other.start._container == this)
+        if (&other == this)
             return *this;
-        clear();
-        start._container = this;
-        finish._container = this;
-        end_of_storage._container = this;
-        start._ptr = (T *)malloc(sizeof(T) * other.capacity());
-        finish._ptr = start._ptr + other.size();
-        end_of_storage._ptr = start._ptr + other.capacity();
-        for (size_type i = 0; i < other.size(); ++i)
-            *(start._ptr + i) = *(other.start._ptr + i);
+        assign(other.start._ptr, other.finish._ptr);
+        return *this;
+	}
+	//steal the buffer of other if this allocator can free it
+	//otherwise move the elements one by one
+	vector &operator =(vector &&other) {
+        if (&other == this)
+            return *this;
+        if (!(_alloc == other._alloc)){
+            assign(std::make_move_iterator(other.start._ptr), std::make_move_iterator(other.finish._ptr));
+            other.clear();
+            return *this;
+        }
+        _steal(other);
         return *this;
 	}
 
@@ -244,12 +364,12 @@ public:
         return *(start + pos);
 	}
 	T &operator [](const size_t &pos) {
-        if (pos >= size())
+        if (checked_access && pos >= size())
             throw index_out_of_bound();
         return *(start + pos);
 	}
 	const T &operator [](const size_type &pos) const {
-        if (pos >= size())
+        if (checked_access && pos >= size())
             throw index_out_of_bound();
         return *(start + pos);
 	}
@@ -263,6 +383,12 @@ public:
             throw container_is_empty();
         return *(finish - 1);
 	}
+	T *data(){
+        return start._ptr;
+	}
+	const T *data() const {
+        return start._ptr;
+	}
 	iterator begin(){
         return start;
 	}
@@ -287,74 +413,1023 @@ public:
 	void clear(){
 	    for (iterator _it = start; _it != finish; ++_it)
             _it._ptr->~T();
-        free(start._ptr);
+        _deallocate(start._ptr, capacity());
         start._ptr = finish._ptr = end_of_storage._ptr = nullptr;
 	}
 
 protected:
+    using _relocatable = std::integral_constant<bool, is_trivially_relocatable<T>::value>;
+    //elements that come to life when their bytes are written
+    using _uninitialized_ok = std::integral_constant<bool,
+        std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value>;
+
+    //take over the storage of other, leaving it empty
+    void _steal(vector &other){
+        clear();
+        start._ptr = other.start._ptr;
+        finish._ptr = other.finish._ptr;
+        end_of_storage._ptr = other.end_of_storage._ptr;
+        other.start._ptr = other.finish._ptr = other.end_of_storage._ptr = nullptr;
+    }
+
+    //use [p, p + cap) holding n elements as the storage, the old one is forgotten without being freed
+    void _set_storage(T *p, size_type n, size_type cap){
+        start._ptr = p;
+        finish._ptr = p + n;
+        end_of_storage._ptr = p + cap;
+    }
+
+    T *_allocate(size_type n){
+        return n == 0 ? nullptr : _alloc.allocate(n);
+    }
+    void _deallocate(T *p, size_type n){
+        if (p != nullptr)
+            _alloc.deallocate(p, n);
+    }
+
+    //resize the storage to cap elements
+    //trivially relocatable elements are relocated as a whole, by Alloc::reallocate if there is one
+    template<class A>
+    auto _resize_bytes(A &a, size_type cap, int) -> decltype(a.reallocate(start._ptr, cap, cap)){
+        return a.reallocate(start._ptr, capacity(), cap);
+    }
+    template<class A>
+    T *_resize_bytes(A &, size_type cap, long){
+        T *_newp = _allocate(cap);
+        if (start._ptr != nullptr)
+            memcpy((void *)_newp, (void *)start._ptr, sizeof(T) * size());
+        _deallocate(start._ptr, capacity());
+        return _newp;
+    }
+    T *_resize_storage(size_type cap, std::true_type){
+        T *_old = start._ptr;
+        T *_newp = _resize_bytes(_alloc, cap, 0);
+        if (_newp != _old)
+            SJTU_STAT(_stats.bytes_moved += sizeof(T) * size());
+        return _newp;
+    }
+    //otherwise elements are moved one by one unless T's move constructor may throw
+    T *_resize_storage(size_type cap, std::false_type){
+        T *_newp = _allocate(cap);
+        _stat_elements(size(), _moves_on_relocation());
+        for (T *_p = start._ptr; _p != finish._ptr; ++_p){
+            new (_newp + (_p - start._ptr)) T(std::move_if_noexcept(*_p));
+            _p->~T();
+        }
+        _deallocate(start._ptr, capacity());
+        return _newp;
+    }
+
+    //shift [pos, finish) n slots right, leaving [pos, pos + n) as raw memory
+    //the capacity must be enough
+    void _open_gap(T *pos, size_type n, std::true_type){
+        SJTU_STAT(_stats.bytes_moved += sizeof(T) * (finish._ptr - pos));
+        memmove((void *)(pos + n), (void *)pos, sizeof(T) * (finish._ptr - pos));
+    }
+    void _open_gap(T *pos, size_type n, std::false_type){
+        T *_end = finish._ptr;
+        _stat_elements(_end - pos, true);
+        for (T *_p = _end; _p != pos; ){
+            --_p;
+            if (_p + n >= _end)
+                new (_p + n) T(std::move(*_p));
+            else
+                *(_p + n) = std::move(*_p);
+        }
+        for (T *_p = pos; _p != pos + n && _p != _end; ++_p)
+            _p->~T();
+    }
+
+    //destroy [pos, pos + n) and shift [pos + n, finish) n slots left
+    void _close_gap(T *pos, size_type n, std::true_type){
+        for (T *_p = pos; _p != pos + n; ++_p)
+            _p->~T();
+        SJTU_STAT(_stats.bytes_moved += sizeof(T) * (finish._ptr - pos - n));
+        memmove((void *)pos, (void *)(pos + n), sizeof(T) * (finish._ptr - pos - n));
+    }
+    void _close_gap(T *pos, size_type n, std::false_type){
+        T *_p = pos;
+        _stat_elements(finish._ptr - pos - n, true);
+        for (; _p + n != finish._ptr; ++_p)
+            *_p = std::move(*(_p + n));
+        for (; _p != finish._ptr; ++_p)
+            _p->~T();
+    }
+
+    //move elements into a storage of cap elements, leaving [ind, ind + n) as raw memory
+    //finish still counts the old elements only
+    void _reallocate_with_gap(size_type cap, size_type ind, size_type n, std::true_type){
+        _reallocate(cap);
+        _open_gap(start._ptr + ind, n, std::true_type());
+    }
+    void _reallocate_with_gap(size_type cap, size_type ind, size_type n, std::false_type){
+        size_type _size = size();
+        T *_newstart = _allocate(cap);
+        SJTU_STAT(++_stats.reallocations);
+        _stat_elements(_size, _moves_on_relocation());
+        for (size_type i = 0; i < _size; ++i){
+            new (_newstart + (i < ind ? i : i + n)) T(std::move_if_noexcept(*(start._ptr + i)));
+            (start._ptr + i)->~T();
+        }
+        _deallocate(start._ptr, capacity());
+        start._ptr = _newstart;
+        finish._ptr = start._ptr + _size;
+        end_of_storage._ptr = start._ptr + cap;
+    }
+
+    //make [pos, pos + n) raw memory, reallocating at most once
+    //return the new position of pos
+    T *_make_gap(T *pos, size_type n){
+        size_type _ind = pos - start._ptr;
+        if (size() + n > capacity())
+            _reallocate_with_gap(_grown_capacity(size() + n), _ind, n, _relocatable());
+        else
+            _open_gap(pos, n, _relocatable());
+        return start._ptr + _ind;
+    }
+
+    //whether move_if_noexcept moves
+    static constexpr bool _moves_on_relocation(){
+        return std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value;
+    }
+    //count n elements relocated one by one
+    void _stat_elements(size_type n, bool moved){
+        SJTU_STAT((moved ? _stats.moves : _stats.copies) += n);
+        SJTU_STAT(_stats.bytes_moved += sizeof(T) * n);
+        (void)n;
+        (void)moved;
+    }
+
+    //number of elements in [first, last)
+    template<class ForwardIt>
+    static size_type _distance(ForwardIt first, ForwardIt last, std::random_access_iterator_tag){
+        return last - first;
+    }
+    template<class ForwardIt>
+    static size_type _distance(ForwardIt first, ForwardIt last, std::forward_iterator_tag){
+        size_type n = 0;
+        for (; first != last; ++first)
+            ++n;
+        return n;
+    }
+
+    //move elements into a storage of exactly cap elements(cap >= size())
+    void _reallocate(size_type cap){
+        size_type _size = size();
+        SJTU_STAT(++_stats.reallocations);
+        start._ptr = _resize_storage(cap, _relocatable());
+        finish._ptr = start._ptr + _size;
+        end_of_storage._ptr = start._ptr + cap;
+    }
     void _reallocate(){
-        if (start._ptr != nullptr){
-            size_type _size = size();
-            T *_newstart = (T *)malloc(sizeof(T) * (_size * 2 + 1));
-            for (size_type i = 0; i < _size; ++i){
-                new (_newstart + i) T(*(start._ptr + i));
-                (start._ptr + i)->~T();
+        _reallocate(Growth::next(capacity()));
+    }
+
+public:
+    stats_type stats() const {
+#ifdef SJTU_STATS
+        return _stats;
+#else
+        return stats_type();
+#endif
+    }
+    void reset_stats(){
+        SJTU_STAT(_stats = stats_type());
+    }
+
+    //make the capacity at least n
+    void reserve(size_type n){
+        if (n > capacity())
+            _reallocate(n);
+    }
+    //release the unused capacity
+    void shrink_to_fit(){
+        if (finish == end_of_storage)
+            return;
+        if (start == finish)
+            clear();
+        else
+            _reallocate(size());
+    }
+    //resize to n elements, new elements are value-initialized
+    void resize(size_type n){
+        if (n > capacity())
+            _reallocate(_grown_capacity(n));
+        while (size() < n){
+            new (finish._ptr) T();
+            ++finish;
+        }
+        _truncate(n);
+    }
+    //resize to n elements, new elements are copies of value
+    void resize(size_type n, const T &value){
+        if (n > capacity()){
+            //value may refer to an element about to be moved
+            T _tmp(value);
+            _reallocate(_grown_capacity(n));
+            _fill_back(n, _tmp);
+        }
+        else
+            _fill_back(n, value);
+        _truncate(n);
+    }
+    //resize to n elements, new elements are default-initialized,
+    //so for trivial T they are left as they are in memory, to be overwritten
+    void resize_default_init(size_type n){
+        if (n > capacity())
+            _reallocate(_grown_capacity(n));
+        if (std::is_trivially_default_constructible<T>::value){
+            if (n > size())
+                finish._ptr = start._ptr + n;
+        }
+        else
+            while (size() < n){
+                new (finish._ptr) T;
+                ++finish;
             }
-            free(start._ptr);
-            start._ptr = _newstart;
-            finish._ptr = start._ptr + _size;
-            end_of_storage._ptr = start._ptr + _size * 2;
+        _truncate(n);
+    }
+
+    /**
+     * make room for n more elements after the end and return where they go.
+     * nothing is constructed there and size() does not change: write into them,
+     * e.g. by read(), then commit_append() how many were written.
+     * any other change to the vector drops what has not been committed.
+     * only for T that needs no construction nor destruction
+     */
+    T *append_uninitialized(size_type n){
+        static_assert(_uninitialized_ok::value, "the elements must be trivially constructible and destructible");
+        if (n > capacity() - size())
+            _reallocate(_grown_capacity(size() + n));
+        return finish._ptr;
+    }
+    //the first n elements after the end are in use now
+    //throw index_out_of_bound if there is no room for them
+    void commit_append(size_type n){
+        static_assert(_uninitialized_ok::value, "the elements must be trivially constructible and destructible");
+        if (n > capacity() - size())
+            throw index_out_of_bound();
+        finish._ptr += n;
+    }
+
+	//replace the contents with n copies of value
+	void assign(size_type n, const T &value){
+        T _tmp(value);
+        _reset_storage(n);
+        _fill_back(n, _tmp);
+	}
+	//replace the contents with [first, last)
+	template<class InputIt, class = _if_iterator<InputIt>>
+	void assign(InputIt first, InputIt last){
+        _assign_range(first, last, typename iterator_traits<InputIt>::iterator_category());
+	}
+
+protected:
+    //destroy all elements and make the capacity at least n
+    void _reset_storage(size_type n){
+        _truncate(0);
+        if (n > capacity()){
+            clear();
+            _reallocate(n);
         }
-        else{
-            start._ptr = (T *)malloc(sizeof(T) * 2);
-            finish._ptr = start._ptr;
-            end_of_storage._ptr = start._ptr + 1;
+    }
+    template<class InputIt>
+    void _assign_range(InputIt first, InputIt last, std::input_iterator_tag){
+        _truncate(0);
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+    template<class ForwardIt>
+    void _assign_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag){
+        _reset_storage(_distance(first, last, typename iterator_traits<ForwardIt>::iterator_category()));
+        for (; first != last; ++first, ++finish._ptr)
+            new (finish._ptr) T(*first);
+    }
+    //single pass ranges are buffered first because their length is unknown
+    template<class InputIt>
+    iterator _insert_range(iterator pos, InputIt first, InputIt last, std::input_iterator_tag){
+        if (pos == finish){
+            size_type _ind = pos - start;
+            for (; first != last; ++first)
+                emplace_back(*first);
+            return start + _ind;
+        }
+        _buffer _buf(first, last);
+        return insert(pos, std::make_move_iterator(_buf.data()), std::make_move_iterator(_buf.data() + _buf.size()));
+    }
+    template<class ForwardIt>
+    iterator _insert_range(iterator pos, ForwardIt first, ForwardIt last, std::forward_iterator_tag){
+        size_type n = _distance(first, last, typename iterator_traits<ForwardIt>::iterator_category());
+        if (n == 0)
+            return pos;
+        pos._ptr = _make_gap(pos._ptr, n);
+        T *_p = pos._ptr;
+        for (; first != last; ++first, ++_p)
+            new (_p) T(*first);
+        finish._ptr += n;
+        return pos;
+    }
+
+    size_type _grown_capacity(size_type n) const {
+        size_type _cap = Growth::next(capacity());
+        return _cap > n ? _cap : n;
+    }
+    void _fill_back(size_type n, const T &value){
+        while (size() < n){
+            new (finish._ptr) T(value);
+            ++finish;
+        }
+    }
+    //destroy the elements from the n-th one
+    void _truncate(size_type n){
+        while (size() > n){
+            --finish;
+            finish._ptr->~T();
         }
     }
 
 public:
-	iterator insert(iterator pos, const T &value){
-	    if (finish == end_of_storage){
-            size_type _dif = pos - start;
-            _reallocate();
-            pos = start + _dif;
+    //construct the new element in front of pos
+    //the arguments may refer to an element of this vector
+    template<class... Args>
+	iterator emplace(iterator pos, Args&&... args){
+	    if (pos == finish && finish != end_of_storage){
+            new (finish._ptr) T(std::forward<Args>(args)...);
+            ++finish;
+            return pos;
 	    }
-        for (iterator _it = finish; _it != pos; --_it){
-            *_it = *(_it - 1);
-        }
-        *pos = value;
+        T _tmp(std::forward<Args>(args)...);
+        pos._ptr = _make_gap(pos._ptr, 1);
+        new (pos._ptr) T(std::move(_tmp));
         ++finish;
         return pos;
 	}
+	iterator insert(iterator pos, const T &value){
+        return emplace(pos, value);
+	}
+	iterator insert(iterator pos, T &&value){
+        return emplace(pos, std::move(value));
+	}
 	iterator insert(const size_type &ind, const T &value) {
         if (ind > size())
             throw index_out_of_bound();
-        return insert(start + ind, value);
+        return emplace(start + ind, value);
+	}
+	iterator insert(const size_type &ind, T &&value) {
+        if (ind > size())
+            throw index_out_of_bound();
+        return emplace(start + ind, std::move(value));
+	}
+	//insert n copies of value in front of pos
+	iterator insert(iterator pos, size_type n, const T &value){
+        if (n == 0)
+            return pos;
+        //value may refer to an element about to be moved
+        T _tmp(value);
+        pos._ptr = _make_gap(pos._ptr, n);
+        for (size_type i = 0; i < n; ++i)
+            new (pos._ptr + i) T(_tmp);
+        finish._ptr += n;
+        return pos;
+	}
+	//insert [first, last) in front of pos
+	//the tail is shifted once and the storage is reallocated at most once
+	template<class InputIt, class = _if_iterator<InputIt>>
+	iterator insert(iterator pos, InputIt first, InputIt last){
+        return _insert_range(pos, first, last, typename iterator_traits<InputIt>::iterator_category());
+	}
+	//a range of this vector itself is copied out first
+	iterator insert(iterator pos, const_iterator first, const_iterator last){
+        if (first._ptr >= start._ptr && first._ptr <= finish._ptr && first != last){
+            _buffer _buf(first._ptr, last._ptr);
+            return insert(pos, std::make_move_iterator(_buf.data()), std::make_move_iterator(_buf.data() + _buf.size()));
+        }
+        return insert(pos, first._ptr, last._ptr);
+	}
+	iterator insert(iterator pos, iterator first, iterator last){
+        return insert(pos, const_iterator(first), const_iterator(last));
 	}
 	iterator erase(iterator pos) {
-        for (iterator _it = pos; _it != finish; ++_it)
-            *_it = *(_it + 1);
-        finish._ptr->~T();
+        _close_gap(pos._ptr, 1, _relocatable());
         --finish;
         return pos;
 	}
+	//erase [first, last)
+	iterator erase(iterator first, iterator last) {
+        if (checked_access && (first._owner() != this || last._owner() != this || last - first < 0))
+            throw invalid_iterator();
+        size_type n = last - first;
+        if (n == 0)
+            return first;
+        _close_gap(first._ptr, n, _relocatable());
+        finish._ptr -= n;
+        return first;
+	}
 	iterator erase(const size_t &ind) {
         if (ind >= size())
             throw index_out_of_bound();
         return erase(start + ind);
 	}
-	void push_back(const T &value) {
-        if (finish == end_of_storage)
+    template<class... Args>
+	void emplace_back(Args&&... args) {
+        if (finish == end_of_storage){
+            //the arguments may refer to an element about to be moved
+            T _tmp(std::forward<Args>(args)...);
             _reallocate();
-        new (finish._ptr) T(value);
+            new (finish._ptr) T(std::move(_tmp));
+        }
+        else
+            new (finish._ptr) T(std::forward<Args>(args)...);
         ++finish;
+	}
+	void push_back(const T &value) {
+        emplace_back(value);
+    }
+	void push_back(T &&value) {
+        emplace_back(std::move(value));
     }
 	void pop_back() {
         if (start == finish)
             throw container_is_empty();
-        finish._ptr->~T();
         --finish;
+        finish._ptr->~T();
+	}
+
+	//write the elements to os or the file descriptor fd, see serialize.hpp
+	//trivially copyable elements are written as one block
+	void save(std::ostream &os) const {
+        binary_writer out(os);
+        save(out);
+	}
+	void save(int fd) const {
+        binary_writer out(fd);
+        save(out);
+        out.flush();
+	}
+	void save(binary_writer &out) const {
+        _save_header(out, serial_vector, sizeof(T), _serial_bulk<T>::value, size());
+        _save_elements(out, _serial_bulk<T>());
+	}
+	//replace the contents with the elements written by save()
+	//trivially copyable elements are read straight into the storage
+	//throw runtime_error if the input holds something else or ends early, leaving the vector empty
+	void load(std::istream &is) {
+        binary_reader in(is);
+        load(in);
+	}
+	void load(int fd) {
+        binary_reader in(fd);
+        load(in);
 	}
+	void load(binary_reader &in) {
+        _truncate(0);
+        size_type n = _load_header(in, serial_vector, sizeof(T), _serial_bulk<T>::value);
+        try {
+            _load_elements(in, n, _serial_bulk<T>());
+        }
+        catch (...) {
+            _truncate(0);
+            throw;
+        }
+	}
+
+protected:
+    void _save_elements(binary_writer &out, std::true_type) const {
+        if (start != finish)
+            out.write(start._ptr, sizeof(T) * size());
+    }
+    void _save_elements(binary_writer &out, std::false_type) const {
+        for (T *_p = start._ptr; _p != finish._ptr; ++_p)
+            serializer<T>::save(out, *_p);
+    }
+    void _load_elements(binary_reader &in, size_type n, std::true_type) {
+        _reset_storage(n);
+        if (n > 0)
+            in.read(start._ptr, sizeof(T) * n);
+        finish._ptr = start._ptr + n;
+    }
+    void _load_elements(binary_reader &in, size_type n, std::false_type) {
+        _reset_storage(n);
+        for (size_type i = 0; i < n; ++i)
+            emplace_back(serializer<T>::load(in));
+    }
+};
+
+template<class T, class Growth, class Alloc>
+struct serializer<vector<T, Growth, Alloc>> {
+    static void save(binary_writer &out, const vector<T, Growth, Alloc> &value) {
+        value.save(out);
+    }
+    static vector<T, Growth, Alloc> load(binary_reader &in) {
+        vector<T, Growth, Alloc> value;
+        value.load(in);
+        return value;
+    }
+};
+
+/**
+ * vector<bool> with the default allocator keeps one bit per element, packed into 64 bit words,
+ * the bits past size() in the last word are always zero.
+ * operator [] and the iterators give a proxy reference, and there is no data();
+ * words() hands out the packed words instead.
+ * count(), find_first(), find_next() and the bitwise operators work a word at a time.
+ * with any other allocator vector<bool> is an ordinary vector of bytes.
+ */
+template<class Growth>
+class vector<bool, Growth, allocator<bool>>{
+public:
+    using value_type        = bool;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using word_type         = uint64_t;
+    using const_reference   = bool;
+    static constexpr size_t word_bits = 64;
+
+private:
+    template<class InputIt>
+    using _if_iterator = typename std::enable_if<!std::is_integral<InputIt>::value>::type;
+
+    vector<word_type, Growth> _words;
+    size_type _size = 0;
+
+public:
+    /**
+     * a reference to one bit
+     */
+    class reference{
+        friend class vector;
+        word_type *_word;
+        word_type _mask;
+        reference(word_type *w, word_type m) : _word(w), _mask(m) {}
+    public:
+        reference(const reference &) = default;
+        operator bool() const {
+            return (*_word & _mask) != 0;
+        }
+        reference &operator =(bool x){
+            if (x)
+                *_word |= _mask;
+            else
+                *_word &= ~_mask;
+            return *this;
+        }
+        reference &operator =(const reference &other){
+            return *this = (bool)other;
+        }
+        bool operator ~() const {
+            return !(bool)*this;
+        }
+        void flip(){
+            *_word ^= _mask;
+        }
+        friend void swap(reference a, reference b){
+            bool t = a;
+            a = (bool)b;
+            b = t;
+        }
+    };
+
+    /**
+     * a random access iterator over the bits, C is vector or const vector
+     */
+    template<class C, class Ref>
+    class _iterator{
+        friend class vector;
+        template<class C2, class Ref2>
+        friend class _iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = bool;
+        using difference_type   = ptrdiff_t;
+        using pointer           = void;
+        using reference         = Ref;
+    private:
+        C *_container = nullptr;
+        size_t _pos = 0;
+        _iterator(C *c, size_t pos) : _container(c), _pos(pos) {}
+    public:
+        _iterator() = default;
+        //an iterator converts to a const_iterator
+        template<class C2, class Ref2, class = typename std::enable_if<std::is_convertible<C2 *, C *>::value>::type>
+        _iterator(const _iterator<C2, Ref2> &other) : _container(other._container), _pos(other._pos) {}
+
+        Ref operator *() const {
+            if (checked_access && (_container == nullptr || _pos >= _container->size()))
+                throw invalid_iterator();
+            return _container->_at(_pos);
+        }
+        _iterator operator +(const difference_type &n) const {
+            return _iterator(_container, _pos + n);
+        }
+        _iterator operator -(const difference_type &n) const {
+            return _iterator(_container, _pos - n);
+        }
+        template<class C2, class Ref2>
+        difference_type operator -(const _iterator<C2, Ref2> &rhs) const {
+            if (checked_access && _container != rhs._container)
+                throw invalid_iterator();
+            return (difference_type)_pos - (difference_type)rhs._pos;
+        }
+        _iterator &operator +=(const difference_type &n){
+            _pos += n;
+            return *this;
+        }
+        _iterator &operator -=(const difference_type &n){
+            _pos -= n;
+            return *this;
+        }
+        _iterator &operator ++(){
+            ++_pos;
+            return *this;
+        }
+        _iterator operator ++(int){
+            _iterator t = *this;
+            ++_pos;
+            return t;
+        }
+        _iterator &operator --(){
+            --_pos;
+            return *this;
+        }
+        _iterator operator --(int){
+            _iterator t = *this;
+            --_pos;
+            return t;
+        }
+        template<class C2, class Ref2>
+        bool operator ==(const _iterator<C2, Ref2> &rhs) const {
+            return _container == rhs._container && _pos == rhs._pos;
+        }
+        template<class C2, class Ref2>
+        bool operator !=(const _iterator<C2, Ref2> &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+    using iterator          = _iterator<vector, reference>;
+    using const_iterator    = _iterator<const vector, bool>;
+
+    vector() {}
+    explicit vector(const allocator<bool> &) {}
+    vector(size_type n, const bool &value, const allocator<bool> & = allocator<bool>()){
+        assign(n, value);
+    }
+    template<class InputIt, class = _if_iterator<InputIt>>
+    vector(InputIt first, InputIt last, const allocator<bool> & = allocator<bool>()){
+        assign(first, last);
+    }
+    vector(const vector &) = default;
+    vector(vector &&other) noexcept : _words(std::move(other._words)), _size(other._size) {
+        other._size = 0;
+    }
+    vector &operator =(const vector &) = default;
+    vector &operator =(vector &&other){
+        if (&other == this)
+            return *this;
+        _words = std::move(other._words);
+        _size = other._size;
+        other._size = 0;
+        return *this;
+    }
+
+    bool at(const size_type &pos) const {
+        if (pos >= _size)
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    reference at(const size_type &pos){
+        if (pos >= _size)
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    bool operator [](const size_type &pos) const {
+        if (checked_access && pos >= _size)
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    reference operator [](const size_type &pos){
+        if (checked_access && pos >= _size)
+            throw index_out_of_bound();
+        return _at(pos);
+    }
+    bool front() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _at(0);
+    }
+    bool back() const {
+        if (_size == 0)
+            throw container_is_empty();
+        return _at(_size - 1);
+    }
+    //the counters of the vector of words, see stats_type of vector
+    using stats_type = typename vector<word_type, Growth>::stats_type;
+    stats_type stats() const {
+        return _words.stats();
+    }
+    void reset_stats(){
+        _words.reset_stats();
+    }
+    //the packed bits, bit i of the vector is bit i % word_bits of word i / word_bits
+    const word_type *words() const {
+        return _words.data();
+    }
+    size_type word_count() const {
+        return _words.size();
+    }
+
+    iterator begin(){
+        return iterator(this, 0);
+    }
+    iterator end(){
+        return iterator(this, _size);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, _size);
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+    size_type size() const {
+        return _size;
+    }
+    size_type capacity() const {
+        return _words.capacity() * word_bits;
+    }
+    void clear(){
+        _words.clear();
+        _size = 0;
+    }
+    void reserve(size_type n){
+        _words.reserve(_word_count(n));
+    }
+    void shrink_to_fit(){
+        _words.shrink_to_fit();
+    }
+    //resize to n elements, new elements are value
+    void resize(size_type n, const bool &value = false){
+        if (n > _size && value && _size % word_bits != 0)
+            _words.data()[_size / word_bits] |= ~word_type(0) << (_size % word_bits);
+        _words.resize(_word_count(n), value ? ~word_type(0) : 0);
+        _size = n;
+        _clear_tail();
+    }
+    //the bits past size() are kept zero, so there is nothing to skip
+    void resize_default_init(size_type n){
+        resize(n);
+    }
+    void assign(size_type n, const bool &value){
+        clear();
+        resize(n, value);
+    }
+    template<class InputIt, class = _if_iterator<InputIt>>
+    void assign(InputIt first, InputIt last){
+        clear();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    void push_back(const bool &value){
+        if (_size % word_bits == 0)
+            _words.push_back(0);
+        if (value)
+            _words.data()[_size / word_bits] |= _bit(_size);
+        ++_size;
+    }
+    void emplace_back(const bool &value){
+        push_back(value);
+    }
+    void pop_back(){
+        if (_size == 0)
+            throw container_is_empty();
+        --_size;
+        _words.data()[_size / word_bits] &= ~_bit(_size);
+        if (_size % word_bits == 0)
+            _words.pop_back();
+    }
+    //the bits from ind on are shifted up a word at a time
+    iterator insert(const size_type &ind, const bool &value){
+        if (ind > _size)
+            throw index_out_of_bound();
+        push_back(false);
+        word_type *p = _words.data();
+        size_t w = ind / word_bits;
+        for (size_t i = (_size - 1) / word_bits; i > w; --i)
+            p[i] = (p[i] << 1) | (p[i - 1] >> (word_bits - 1));
+        word_type low = _bit(ind) - 1;
+        p[w] = (p[w] & low) | ((p[w] & ~low) << 1);
+        _at(ind) = value;
+        return iterator(this, ind);
+    }
+    iterator insert(iterator pos, const bool &value){
+        return insert(_index(pos), value);
+    }
+    //the bits after ind are shifted down a word at a time
+    iterator erase(const size_type &ind){
+        if (ind >= _size)
+            throw index_out_of_bound();
+        word_type *p = _words.data();
+        size_t w = ind / word_bits, last = (_size - 1) / word_bits;
+        word_type low = _bit(ind) - 1;
+        p[w] = (p[w] & low) | ((p[w] >> 1) & ~low);
+        for (size_t i = w + 1; i <= last; ++i){
+            p[i - 1] |= p[i] << (word_bits - 1);
+            p[i] >>= 1;
+        }
+        --_size;
+        if (_size % word_bits == 0)
+            _words.pop_back();
+        return iterator(this, ind);
+    }
+    iterator erase(iterator pos){
+        return erase(_index(pos));
+    }
+
+    //the number of set bits
+    size_type count() const {
+        const word_type *p = _words.data();
+        size_type n = 0;
+        for (size_t i = 0; i < _words.size(); ++i)
+            n += _popcount(p[i]);
+        return n;
+    }
+    bool any() const {
+        return find_first() != _size;
+    }
+    bool none() const {
+        return !any();
+    }
+    bool all() const {
+        return count() == _size;
+    }
+    //the index of the first set bit, or size() if there is none
+    size_type find_first() const {
+        return _find_from(0);
+    }
+    //the index of the first set bit after pos, or size() if there is none
+    size_type find_next(size_type pos) const {
+        if (pos + 1 >= _size)
+            return _size;
+        return _find_from(pos + 1);
+    }
+    //invert every bit
+    void flip(){
+        word_type *p = _words.data();
+        for (size_t i = 0; i < _words.size(); ++i)
+            p[i] = ~p[i];
+        _clear_tail();
+    }
+
+    //bitwise operations between vectors of the same size
+    //throw runtime_error if the sizes differ
+    vector &operator &=(const vector &other){
+        _check_size(other);
+        word_type *p = _words.data();
+        const word_type *q = other._words.data();
+        for (size_t i = 0; i < _words.size(); ++i)
+            p[i] &= q[i];
+        return *this;
+    }
+    vector &operator |=(const vector &other){
+        _check_size(other);
+        word_type *p = _words.data();
+        const word_type *q = other._words.data();
+        for (size_t i = 0; i < _words.size(); ++i)
+            p[i] |= q[i];
+        return *this;
+    }
+    vector &operator ^=(const vector &other){
+        _check_size(other);
+        word_type *p = _words.data();
+        const word_type *q = other._words.data();
+        for (size_t i = 0; i < _words.size(); ++i)
+            p[i] ^= q[i];
+        return *this;
+    }
+    friend vector operator &(vector a, const vector &b){
+        return a &= b;
+    }
+    friend vector operator |(vector a, const vector &b){
+        return a |= b;
+    }
+    friend vector operator ^(vector a, const vector &b){
+        return a ^= b;
+    }
+    vector operator ~() const {
+        vector v(*this);
+        v.flip();
+        return v;
+    }
+    bool operator ==(const vector &other) const {
+        return _size == other._size
+               && (_size == 0 || memcmp(_words.data(), other._words.data(), sizeof(word_type) * _words.size()) == 0);
+    }
+    bool operator !=(const vector &other) const {
+        return !(*this == other);
+    }
+
+    //the words are saved as they are, with 0 as the element size in the header
+    void save(std::ostream &os) const {
+        binary_writer out(os);
+        save(out);
+    }
+    void save(int fd) const {
+        binary_writer out(fd);
+        save(out);
+        out.flush();
+    }
+    void save(binary_writer &out) const {
+        _save_header(out, serial_vector, 0, true, _size);
+        if (_size > 0)
+            out.write(_words.data(), sizeof(word_type) * _words.size());
+    }
+    void load(std::istream &is){
+        binary_reader in(is);
+        load(in);
+    }
+    void load(int fd){
+        binary_reader in(fd);
+        load(in);
+    }
+    void load(binary_reader &in){
+        clear();
+        size_type n = _load_header(in, serial_vector, 0, true);
+        _words.resize(_word_count(n));
+        try {
+            if (n > 0)
+                in.read(_words.data(), sizeof(word_type) * _words.size());
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+        _size = n;
+        _clear_tail();
+    }
+
+private:
+    static size_type _word_count(size_type n){
+        return (n + word_bits - 1) / word_bits;
+    }
+    static word_type _bit(size_type pos){
+        return (word_type)1 << (pos % word_bits);
+    }
+    reference _at(size_type pos){
+        return reference(_words.data() + pos / word_bits, _bit(pos));
+    }
+    bool _at(size_type pos) const {
+        return (_words.data()[pos / word_bits] & _bit(pos)) != 0;
+    }
+    size_type _index(const iterator &pos) const {
+        if (checked_access && pos._container != this)
+            throw invalid_iterator();
+        return pos._pos;
+    }
+    //zero the bits past _size in the last word
+    void _clear_tail(){
+        if (_size % word_bits != 0)
+            _words.data()[_size / word_bits] &= _bit(_size) - 1;
+    }
+    void _check_size(const vector &other) const {
+        if (_size != other._size)
+            throw runtime_error();
+    }
+    size_type _find_from(size_type pos) const {
+        const word_type *p = _words.data();
+        size_t i = pos / word_bits;
+        if (i >= _words.size())
+            return _size;
+        word_type w = p[i] & ~(_bit(pos) - 1);
+        while (w == 0){
+            if (++i == _words.size())
+                return _size;
+            w = p[i];
+        }
+        return i * word_bits + _ctz(w);
+    }
+
+    static size_t _popcount(word_type w){
+#ifdef __GNUC__
+        return __builtin_popcountll(w);
+#else
+        size_t n = 0;
+        for (; w != 0; w &= w - 1)
+            ++n;
+        return n;
+#endif
+    }
+    static size_t _ctz(word_type w){
+#ifdef __GNUC__
+        return __builtin_ctzll(w);
+#else
+        size_t n = 0;
+        for (; (w & 1) == 0; w >>= 1)
+            ++n;
+        return n;
+#endif
+    }
 };
 }
 